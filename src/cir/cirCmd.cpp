@@ -25,7 +25,8 @@ initCirCmd()
          cmdMgr->regCmd("CIRPrint", 4, new CirPrintCmd) &&
          cmdMgr->regCmd("CIRGate", 4, new CirGateCmd) &&
          cmdMgr->regCmd("CIRWrite", 4, new CirWriteCmd) &&
-         cmdMgr->regCmd("CIRSatRAR", 4, new CirSatRARCmd)
+         cmdMgr->regCmd("CIRSatRAR", 4, new CirSatRARCmd) &&
+         cmdMgr->regCmd("CIRProbe", 6, new CirProbeCmd)
       )) {
       cerr << "Registering \"cir\" commands fails... exiting" << endl;
       return false;
@@ -291,7 +292,13 @@ CirWriteCmd::help() const
 
 
 //----------------------------------------------------------------------
-//    CIRSatRARCmd
+//    CIRSatRAR [-Aig | -Lazy | -Window <(int k)>] [-Threads <(int num)>]
+//              [-APply [-Verify]] [-Multi] [-NOSim]
+//              [-Order <Fanout | Level | Cone | Gain>]
+//              [-TOp <(int k)>] [-TImeout <(int sec)>] [-MAXTargets <(int num)>]
+//              [-MAXCands <(int num)>] [-Budget <(int props)>]
+//              [-OUtput <(string file.csv | file.jsonl)>]
+//              [-CHeckpoint <(string file)>] [-Resume <(string file)>]
 //----------------------------------------------------------------------
 CmdExecStatus
 CirSatRARCmd::exec(const string& option)
@@ -301,7 +308,202 @@ CirSatRARCmd::exec(const string& option)
       return CMD_EXEC_ERROR;
    }
    // check option
-   cirMgr->satRAR();
+   vector<string> options;
+   if (!CmdExec::lexOptions(option, options))
+      return CMD_EXEC_ERROR;
+
+   RarOption opt;
+   string outName, resumeName;
+   bool threadsSet = false;   // (opt.threads is 1 by default)
+   for (size_t i = 0, n = options.size(); i < n; ++i) {
+      if (myStrNCmp("-Aig", options[i], 2) == 0) {
+         if (opt.aigImp || opt.lazyCnf || opt.window)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         opt.aigImp = true;
+      }
+      else if (myStrNCmp("-Lazy", options[i], 2) == 0) {
+         if (opt.aigImp || opt.lazyCnf || opt.window)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         opt.lazyCnf = true;
+      }
+      else if (myStrNCmp("-Window", options[i], 2) == 0) {
+         if (opt.aigImp || opt.lazyCnf || opt.window)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         int num;
+         if (!myStr2Int(options[i], num) || num < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         opt.window = num;
+      }
+      else if (myStrNCmp("-Order", options[i], 2) == 0) {
+         if (opt.order != RAR_ORDER_ID)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         if (myStrNCmp("Fanout", options[i], 1) == 0) opt.order = RAR_ORDER_FANOUT;
+         else if (myStrNCmp("Level", options[i], 1) == 0) opt.order = RAR_ORDER_LEVEL;
+         else if (myStrNCmp("Cone", options[i], 1) == 0) opt.order = RAR_ORDER_CONE;
+         else if (myStrNCmp("Gain", options[i], 1) == 0) opt.order = RAR_ORDER_GAIN;
+         else
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+      }
+      else if (myStrNCmp("-Multi", options[i], 2) == 0) {
+         if (opt.multi)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         opt.multi = true;
+      }
+      else if (myStrNCmp("-NOSim", options[i], 4) == 0) {
+         if (!opt.simFilter)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         opt.simFilter = false;
+      }
+      else if (myStrNCmp("-APply", options[i], 3) == 0) {
+         if (opt.apply)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         opt.apply = true;
+      }
+      else if (myStrNCmp("-Verify", options[i], 2) == 0) {
+         if (opt.verify)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         opt.verify = true;
+      }
+      else if (myStrNCmp("-Threads", options[i], 2) == 0) {
+         if (threadsSet)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         threadsSet = true;
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         int threads;
+         if (!myStr2Int(options[i], threads) || threads < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         opt.threads = threads;
+      }
+      else if (myStrNCmp("-TImeout", options[i], 3) == 0) {
+         if (opt.timeout)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         int num;
+         if (!myStr2Int(options[i], num) || num < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         opt.timeout = num;
+      }
+      else if (myStrNCmp("-TOp", options[i], 3) == 0) {
+         if (opt.top)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         int num;
+         if (!myStr2Int(options[i], num) || num < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         opt.top = num;
+      }
+      else if (myStrNCmp("-MAXTargets", options[i], 5) == 0) {
+         if (opt.maxTargets)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         int num;
+         if (!myStr2Int(options[i], num) || num < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         opt.maxTargets = num;
+      }
+      else if (myStrNCmp("-MAXCands", options[i], 5) == 0) {
+         if (opt.maxCands)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         int num;
+         if (!myStr2Int(options[i], num) || num < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         opt.maxCands = num;
+      }
+      else if (myStrNCmp("-Budget", options[i], 2) == 0) {
+         if (opt.maxProps)
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         int num;
+         if (!myStr2Int(options[i], num) || num < 1)
+            return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+         opt.maxProps = num;
+      }
+      else if (myStrNCmp("-OUtput", options[i], 3) == 0) {
+         if (!outName.empty())
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         outName = options[i];
+      }
+      else if (myStrNCmp("-CHeckpoint", options[i], 3) == 0) {
+         if (!opt.checkpoint.empty())
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         opt.checkpoint = options[i];
+      }
+      else if (myStrNCmp("-Resume", options[i], 2) == 0) {
+         if (!resumeName.empty())
+            return CmdExec::errorOption(CMD_OPT_EXTRA, options[i]);
+         if (++i == n)
+            return CmdExec::errorOption(CMD_OPT_MISSING, options[i-1]);
+         resumeName = options[i];
+      }
+      else
+         return CmdExec::errorOption(CMD_OPT_ILLEGAL, options[i]);
+   }
+   if (opt.verify && !opt.apply) {
+      cerr << "Error: -Verify checks the netlist rewritten by -APply!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // the solver of -Lazy grows with the targets of its thread, so its
+   // output would depend on how the targets are dealt out
+   if (opt.lazyCnf && opt.threads > 1) {
+      cerr << "Error: -Lazy cannot be run on more than one thread!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // CSV for a ".csv" file, JSON Lines otherwise
+   ofstream outfile;
+   if (!outName.empty()) {
+      outfile.open(outName.c_str(), ios::out);
+      if (!outfile)
+         return CmdExec::errorOption(CMD_OPT_FOPEN_FAIL, outName);
+      size_t n = outName.size();
+      opt.out = &outfile;
+      opt.csv = n >= 4 && myStrNCmp(".csv", outName.substr(n - 4), 4) == 0;
+   }
+   // -Resume: the run must have the same options, and go on with the netlist
+   // of the checkpoint (-APply) or with the same netlist
+   RarCheckpoint ck;
+   if (!resumeName.empty()) {
+      if (!ck.read(resumeName)) {
+         cerr << "Error: \"" << resumeName << "\" is not a CIRSatRAR checkpoint!!" << endl;
+         return CMD_EXEC_ERROR;
+      }
+      if (!ck.sameOptions(opt)) {
+         cerr << "Error: checkpoint \"" << resumeName << "\" was saved with other options!!" << endl;
+         return CMD_EXEC_ERROR;
+      }
+      if (opt.apply) {
+         // (ck.read() checked that the netlist reads back as itself)
+         CirMgr* mgr = new CirMgr;
+         istringstream aag(ck.netlist);
+         mgr->readCircuit(aag);
+         delete cirMgr;
+         cirMgr = mgr;
+      }
+      else {
+         stringstream aag;
+         cirMgr->writeAag(aag);
+         if (aag.str() != ck.netlist) {
+            cerr << "Error: checkpoint \"" << resumeName << "\" is of another netlist!!" << endl;
+            return CMD_EXEC_ERROR;
+         }
+      }
+      opt.resume = &ck;
+   }
+   cirMgr->satRAR(opt);
 
    return CMD_EXEC_DONE;
 }
@@ -309,12 +511,53 @@ CirSatRARCmd::exec(const string& option)
 void
 CirSatRARCmd::usage(ostream& os) const
 {
-   os << "Usage: CIRWrite [-Output (string aagFile)]" << endl;
+   os << "Usage: CIRSatRAR [-Aig | -Lazy | -Window <(int k)>] [-Threads <(int num)>]" << endl
+      << "                 [-APply [-Verify]] [-Multi] [-NOSim]" << endl
+      << "                 [-Order <Fanout | Level | Cone | Gain>]" << endl
+      << "                 [-TOp <(int k)>] [-TImeout <(int sec)>] [-MAXTargets <(int num)>]" << endl
+      << "                 [-MAXCands <(int num)>] [-Budget <(int props)>]" << endl
+      << "                 [-OUtput <(string file.csv | file.jsonl)>]" << endl
+      << "                 [-CHeckpoint <(string file)>] [-Resume <(string file)>]" << endl;
 }
 
 void
 CirSatRARCmd::help() const
 {
-   cout << setw(15) << left << "CIRWrite: "
-        << "write the netlist to an ASCII AIG file (.aag)\n";
+   cout << setw(15) << left << "CIRSatRAR: "
+        << "find alternative wires/gates by redundancy addition and removal\n";
+}
+
+//----------------------------------------------------------------------
+//    CIRProbe
+//----------------------------------------------------------------------
+CmdExecStatus
+CirProbeCmd::exec(const string& option)
+{
+   if (!cirMgr) {
+      cerr << "Error: circuit is not yet constructed!!" << endl;
+      return CMD_EXEC_ERROR;
+   }
+   // check option
+   vector<string> options;
+   CmdExec::lexOptions(option, options);
+
+   if (!options.empty())
+      return CmdExec::errorOption(CMD_OPT_EXTRA, options[0]);
+
+   cirMgr->probe();
+
+   return CMD_EXEC_DONE;
+}
+
+void
+CirProbeCmd::usage(ostream& os) const
+{
+   os << "Usage: CIRProbe" << endl;
+}
+
+void
+CirProbeCmd::help() const
+{
+   cout << setw(15) << left << "CIRProbe: "
+        << "merge constant and equivalent gates found by failed-literal probing\n";
 }
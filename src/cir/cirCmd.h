@@ -16,5 +16,6 @@ CmdClass(CirPrintCmd);
 CmdClass(CirGateCmd);
 CmdClass(CirWriteCmd);
 CmdClass(CirSatRARCmd);
+CmdClass(CirProbeCmd);
 
 #endif // CIR_CMD_H
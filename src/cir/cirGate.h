@@ -55,6 +55,7 @@ class CirGate
    CirGate* rprint(const CirGate* p,int level)const;
    CirGate* revrprint(const CirGate*,int level)const;
    void pushFanout(CirGate* p){_fanout.push_back(p);}
+   void removeFanout(CirGate* p){for(size_t i=0;i<_fanout.size();++i){if(_fanout[i]==p){_fanout.erase(_fanout.begin()+i);return;}}}
    vector<CirGate*> getFanout()const{return _fanout;}
    //helper function
    virtual int getID() const{};
@@ -0,0 +1,146 @@
+/****************************************************************************
+  FileName     [ cirImp.cpp ]
+  PackageName  [ cir ]
+  Synopsis     [ Define AIG implication engine for mandatory assignments ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cassert>
+#include "cirImp.h"
+#include "cirGate.h"
+
+using namespace std;
+
+/**************************************/
+/*   class CirImp member functions    */
+/**************************************/
+const unsigned CirImp::NO_FANIN;
+
+void
+CirImp::build(const map<int, CirGate*>& gateMap)
+{
+   unsigned n = gateMap.empty()? 1: gateMap.rbegin()->first + 1;
+   _fanin.assign(2 * n, NO_FANIN);
+   _foStart.assign(n + 1, 0);
+   _val.assign(n, 2);
+   _blocked.assign(n, 0);
+   _blockedIds.clear();
+   _trail.clear(); _qhead = 0;
+   _implied.clear();
+
+   // fanins, and count the AIG fanouts of each gate
+   for (auto it = gateMap.begin(); it != gateMap.end(); ++it) {
+      CirGate* g = it->second;
+      if (g->getTypeStr() != "Aig") continue;
+      unsigned f0 = g->getFanin0()->getID(), f1 = g->getFanin1()->getID();
+      _fanin[2 * it->first]     = (f0 << 1) | g->getInv0();
+      _fanin[2 * it->first + 1] = (f1 << 1) | g->getInv1();
+      ++_foStart[f0 + 1];
+      if (f1 != f0) ++_foStart[f1 + 1];
+   }
+   for (unsigned i = 0; i < n; ++i)
+      _foStart[i + 1] += _foStart[i];
+   _fo.resize(_foStart[n]);
+   vector<unsigned> fill(_foStart.begin(), _foStart.end() - 1);
+   for (auto it = gateMap.begin(); it != gateMap.end(); ++it) {
+      if (_fanin[2 * it->first] == NO_FANIN) continue;
+      unsigned f0 = _fanin[2 * it->first] >> 1, f1 = _fanin[2 * it->first + 1] >> 1;
+      _fo[fill[f0]++] = it->first;
+      if (f1 != f0) _fo[fill[f1]++] = it->first;
+   }
+}
+
+void
+CirImp::setBlocked(const vector<int>& ids)
+{
+   clearBlocked();
+   for (size_t i = 0, n = ids.size(); i < n; ++i)
+      if (!_blocked[ids[i]]) {
+         _blocked[ids[i]] = 1;
+         _blockedIds.push_back(ids[i]);
+      }
+}
+
+void
+CirImp::clearBlocked()
+{
+   for (size_t i = 0, n = _blockedIds.size(); i < n; ++i)
+      _blocked[_blockedIds[i]] = 0;
+   _blockedIds.clear();
+}
+
+bool
+CirImp::imply(const vector<int>& ids, const vector<bool>& vals)
+{
+   assert(ids.size() == vals.size());
+   _implied.clear();
+   for (size_t i = 0, n = ids.size(); i < n; ++i)
+      if (!assign(ids[i], vals[i]) || !propagate())
+         return false;
+   return true;
+}
+
+void
+CirImp::reset()
+{
+   for (size_t i = 0, n = _trail.size(); i < n; ++i)
+      _val[_trail[i]] = 2;
+   _trail.clear();
+   _qhead = 0;
+}
+
+// return false if "id" already has the other value
+bool
+CirImp::assign(unsigned id, char v)
+{
+   if (_val[id] != 2) return _val[id] == v;
+   _val[id] = v;
+   _trail.push_back(id);
+   return true;
+}
+
+bool
+CirImp::propagate()
+{
+   while (_qhead < _trail.size()) {
+      if (_propsLeft == 0) { _implied.clear(); return true; }
+      if (_propsLeft > 0) --_propsLeft;
+      unsigned id = _trail[_qhead++];
+      if (_blocked[id]) continue;
+      _implied.push_back(id);
+      // backward through "id" itself, forward through its fanouts
+      bool ok = _fanin[2 * id] == NO_FANIN || implyAig(id);
+      for (unsigned i = _foStart[id], n = _foStart[id + 1]; ok && i < n; ++i)
+         ok = implyAig(_fo[i]);
+      if (!ok) { _qhead = _trail.size(); return false; }
+   }
+   return true;
+}
+
+// apply the AND-gate rules of "g" under the current values; none for a
+// blocked gate, which is only assigned by the rules of its fanouts
+bool
+CirImp::implyAig(unsigned g)
+{
+   if (_blocked[g]) return true;
+   unsigned la = _fanin[2 * g], lb = _fanin[2 * g + 1];
+   char vg = _val[g], va = litValue(la), vb = litValue(lb);
+   if (va == 0 || vb == 0) {
+      if (!assign(g, 0)) return false;
+   }
+   else if (va == 1 && vb == 1) {
+      if (!assign(g, 1)) return false;
+   }
+   else if (vg == 1) {
+      if (!assignLit(la, 1) || !assignLit(lb, 1)) return false;
+   }
+   else if (vg == 0) {
+      if (la == lb && !assignLit(la, 0)) return false;   // g = a & a
+      if (va == 1 && !assignLit(lb, 0)) return false;
+      if (vb == 1 && !assignLit(la, 0)) return false;
+   }
+   return true;
+}
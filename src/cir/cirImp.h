@@ -0,0 +1,78 @@
+/****************************************************************************
+  FileName     [ cirImp.h ]
+  PackageName  [ cir ]
+  Synopsis     [ Define AIG implication engine for mandatory assignments ]
+  Author       [ Chung-Yang (Ric) Huang ]
+  Copyright    [ Copyleft(c) 2008-present LaDs(III), GIEE, NTU, Taiwan ]
+****************************************************************************/
+
+#ifndef CIR_IMP_H
+#define CIR_IMP_H
+
+#include <vector>
+#include <map>
+
+using namespace std;
+
+#include "cirDef.h"
+
+// Implication (BCP) directly on the AIG, for AND gate g = a & b:
+//    forward:  a = 0 or b = 0 -> g = 0;  a = 1 and b = 1 -> g = 1
+//    backward: g = 1 -> a = 1, b = 1;    g = 0 and a = 1 -> b = 0 (and vice versa)
+// With no gate blocked this is unit propagation on the CNF of genAigModel.
+// A blocked gate has none of these rules: it is assigned only by the
+// backward rules of its fanouts and implies nothing. (RARSolve skips only the
+// watches of a blocked variable, so its MAs can differ from these)
+// Values are kept in flat arrays indexed by gate ID; every assignment is
+// recorded on a trail so that reset() costs O(#assigned).
+class CirImp
+{
+public:
+   CirImp(): _qhead(0), _propsLeft(-1) {}
+   ~CirImp() {}
+
+   // flatten the AIG (fanins and AND-gate fanouts) of GateMap
+   void build(const map<int, CirGate*>& gateMap);
+
+   // drop the rules of the gates in "ids" (they can still be assigned);
+   // replaces the previous set, O(#ids)
+   void setBlocked(const vector<int>& ids);
+   void clearBlocked();
+
+   // assign ids[i] = vals[i] one by one, propagating after each;
+   // return false on conflict (the implications found so far are kept)
+   bool imply(const vector<int>& ids, const vector<bool>& vals);
+   // gates dequeued by the last imply(), in order (blocked gates excluded)
+   const vector<unsigned>& getImplied() const { return _implied; }
+   // 0, 1, or 2 (free)
+   char getValue(unsigned id) const { return _val[id]; }
+   // unassign everything
+   void reset();
+   // let the following imply() calls dequeue "props" gates in total (< 0: no
+   // limit); once they are used up, imply() stops early and budgetOut() is true
+   void setBudget(long long props) { _propsLeft = props; }
+   bool budgetOut() const { return _propsLeft == 0; }
+
+private:
+   static const unsigned   NO_FANIN = unsigned(-1);
+
+   vector<unsigned>        _fanin;    // 2 per gate: (fanin ID << 1) | inv, NO_FANIN if not AIG
+   vector<unsigned>        _foStart;  // AIG fanouts of gate i: _fo[_foStart[i] .. _foStart[i+1])
+   vector<unsigned>        _fo;
+   vector<char>            _val;      // 0, 1, or 2 (free)
+   vector<char>            _blocked;
+   vector<unsigned>        _blockedIds;
+   vector<unsigned>        _trail;    // assigned gates in assignment order
+   size_t                  _qhead;    // next gate on _trail to propagate
+   vector<unsigned>        _implied;
+   long long               _propsLeft;
+
+   bool assign(unsigned id, char v);
+   bool assignLit(unsigned lit, char v) { return assign(lit >> 1, v ^ (lit & 1)); }
+   char litValue(unsigned lit) const {
+      char v = _val[lit >> 1]; return v == 2? 2: v ^ (lit & 1); }
+   bool propagate();
+   bool implyAig(unsigned g);
+};
+
+#endif // CIR_IMP_H
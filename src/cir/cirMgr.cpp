@@ -16,9 +16,17 @@
 #include <map>
 #include <sstream>
 #include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <atomic>
 #include "cirMgr.h"
 #include "cirGate.h"
+#include "cirImp.h"
 #include "util.h"
+#include "rnGen.h"
 #include "../sat/sat.h"
 
 using namespace std;
@@ -156,9 +164,15 @@ parseError(CirParseError err)
 bool
 CirMgr::readCircuit(const string& fileName)
 {
-   const0=new CirConstGate();
    ifstream f(fileName.c_str());
    if(!f.is_open()){cout<<"Cannot open design \""<<fileName.c_str()<<"\"!!"<<endl;return false;}
+   return readCircuit(f);
+}
+
+bool
+CirMgr::readCircuit(istream& f)
+{
+   const0=new CirConstGate();
    string line;
    getline(f,line);
    readHeader(line);
@@ -269,7 +283,14 @@ CirMgr::printFloatGates() const
 void
 CirMgr::writeAag(ostream& outfile) const
 {
-   outfile<<"aag "<<M<<" "<<I<<" 0 "<<O<<" "<<A-flAIG<<endl;
+   // AIGs reachable from the POs (the netlist may have been changed by CIRProbe)
+   stringstream aigs;
+   for(unsigned i=0;i<_polist.size();++i){
+      writeDFS(_polist[i],aigs);
+   }
+   resetprint();
+   string aigStr=aigs.str();
+   outfile<<"aag "<<M<<" "<<I<<" 0 "<<O<<" "<<count(aigStr.begin(),aigStr.end(),'\n')<<endl;
    for(unsigned i=0;i<_pilist.size();++i){
       outfile<<_pilist[i]->getID()*2<<endl;
    }
@@ -277,10 +298,7 @@ CirMgr::writeAag(ostream& outfile) const
       if(_polist[i]->getInv0()){outfile<<_polist[i]->getFanin0()->getID()*2+1<<endl;}
       else{outfile<<_polist[i]->getFanin0()->getID()*2<<endl;}
    }
-   for(unsigned i=0;i<_polist.size();++i){
-      writeDFS(_polist[i],outfile);
-   }
-   resetprint();
+   outfile<<aigStr;
    for(unsigned i=0;i<_pilist.size();++i){
       if(_pilist[i]->getSymbol()!=""){outfile<<"i"<<i<<" "<<_pilist[i]->getSymbol()<<endl;}
    }
@@ -386,14 +404,14 @@ void CirMgr::readSymbol(string symbol)
    int index;
    getline(iss,s,' ');
    if(s[0]=='i'){
-      string  s1=s1.assign(s,1,s.size()-1);
+      string  s1=s.substr(1);
       ss<<s1;
       ss>>index;
       getline(iss,s,' ');
       _pilist[index]->setSymbol(s);  
    }
    else if(s[0]=='o'){
-      string  s1=s1.assign(s,1,s.size()-1);
+      string  s1=s.substr(1);
       ss<<s1;
       ss>>index;
       getline(iss,s,' ');
@@ -733,23 +751,6 @@ bool CirMgr::combineMAs(map<int, int>& MA1, map<int, int>& MA2) {
    return true;
 }
 
-void CirMgr::compareTwogds(vector<pair<int, int>>& gds1, vector<pair<int,int>>& gds2) {
-   int i = 0, tmp =0;
-   while (i < gds1.size()) {
-      for (auto it=gds2.begin(); it!=gds2.end(); it++) {
-         if(gds1[i].first == it->first) {
-            tmp = 1;
-         }
-      }
-      if (tmp == 0) {
-         gds1.erase(gds1.begin()+i);
-      } else {
-         i++;
-         tmp = 0;
-      }
-   }
-}
-
 class Gate
 {
 public:
@@ -766,6 +767,7 @@ private:
 
 void genAigModel(SatSolver& s, vector<Gate*>& gates, map<int, CirGate *>& GateMap) {
    // Allocate and record variables; No Var ID for POs
+   gates[0]->setVar(0);    // CONST0: the variable made by SatSolver::initialize()
    for (size_t i=1; i<gates.size(); ++i) {
       Var v = s.newVar();
       gates[i]->setVar(v);
@@ -889,344 +891,1806 @@ void genAigModel(SatSolver& s, vector<Gate*>& gates, map<int, CirGate *>& GateMa
 //    }
 // }
 
-void clear_MA(map<int, int>& MA) {
-   for (auto it=MA.begin();it!=MA.end();++it){
-      it->second = 2;
+// Values 0, 1 or 2 (free) of the gates, indexed by gate ID. An entry is only
+// valid if its stamp is the current epoch, so clear() is O(1); the entries
+// assigned since the last clear() are listed in touched()
+class RarMA
+{
+public:
+   RarMA(size_t n = 0) { init(n); }
+
+   void init(size_t n) { _val.assign(n, 2); _stamp.assign(n, 0); _epoch = 1; _touched.clear(); }
+   int operator[] (unsigned id) const { return _stamp[id] == _epoch? _val[id]: 2; }
+   void set(unsigned id, int v) {
+      if (_stamp[id] != _epoch) { _stamp[id] = _epoch; _touched.push_back(id); }
+      _val[id] = v;
+   }
+   void clear() {
+      if (++_epoch == 0) { _stamp.assign(_stamp.size(), 0); _epoch = 1; }
+      _touched.clear();
+   }
+   const vector<unsigned>& touched() const { return _touched; }
+
+private:
+   vector<signed char>  _val;
+   vector<unsigned>     _stamp;
+   unsigned             _epoch;
+   vector<unsigned>     _touched;
+};
+
+// record the literals implied by the last assumpRARSolve into MA (Var == gate ID)
+void record_MA(const SatSolver& s, RarMA& MA) {
+   const vec<Lit>& imp = s.getImplied();
+   for (int i=0; i<imp.size(); ++i) {
+      MA.set(var(imp[i]), !sign(imp[i]));
    }
 }
 
-void CirMgr:: findAllgd(int Id, vector<pair<int,int>>& gds, map<int, int>& check_gd) {
-   for (size_t i=0; i<GateMap[Id]->getFanout().size(); ++i) {
-      if (GateMap[Id]->getFanout()[i]->getTypeStr() == "Aig" && check_gd[GateMap[Id]->getFanout()[i]->getID()] == 2) {
-         if (GateMap[Id]->getFanout()[i]->getFanin0()->getID() == Id) {
-            check_gd[GateMap[Id]->getFanout()[i]->getID()] = 1;
-            gds.push_back(pair<int, int>(GateMap[Id]->getFanout()[i]->getID(), 0));
-         } else {
-            check_gd[GateMap[Id]->getFanout()[i]->getID()] = 1;
-            gds.push_back(pair<int, int>(GateMap[Id]->getFanout()[i]->getID(), 1));
+// Local window of a target for CIRSatRAR -Window k: its fanouts up to k levels
+// and their fanins up to k levels. Its solver has only the CNF of the AIG gates
+// of the window whose fanins are both in it, with Var i for gate ids[i].
+// With -Lazy, the gates encoded so far in the solver of a worker
+struct RarWindow
+{
+   RarWindow(size_t n): ids(1, 0), var(n, -1), tfo(n, 0) { var[0] = 0; }
+   vector<int>    ids;     // local Var -> gate ID (CONST0 is Var 0)
+   vector<int>    var;     // gate ID -> local Var, -1 outside the window
+   vector<char>   tfo;     // gate ID -> a fanout of the target within k levels
+                           // (-Lazy: in the TFO of a target encoded so far)
+};
+
+// compute the MAs of the assumptions vv = vb without propagating through the
+// gates in "blocked", with CirImp (-Aig) or the SAT solver; the result is
+// recorded into MA. The solver keeps its assignments so that a following
+// query sharing a prefix of vv (e.g. the same Gd) does not redo it.
+// With "win", the solver is the one of the window and vv must lie in it
+bool CirMgr::rarImply(SatSolver& s, CirImp& imp, const vector<Var>& vv, const vector<bool>& vb,
+                      const vector<int>& blocked, RarMA& MA, const RarWindow* win) {
+   bool result;
+   if (_rarOpt.aigImp) {
+      imp.setBlocked(blocked);
+      result = imp.imply(vv, vb);
+      const vector<unsigned>& implied = imp.getImplied();
+      for (size_t i=0; i<implied.size(); ++i) {
+         MA.set(implied[i], imp.getValue(implied[i]));
+      }
+      imp.reset();
+   }
+   else if (win) {
+      vector<Var> lv(vv.size());
+      vector<int> lb;
+      for (size_t i=0; i<vv.size(); ++i) {
+         assert(win->var[vv[i]] >= 0);
+         lv[i] = win->var[vv[i]];
+      }
+      for (size_t i=0; i<blocked.size(); ++i) {
+         if (win->var[blocked[i]] >= 0) lb.push_back(win->var[blocked[i]]);
+      }
+      s.assumeRelease();
+      s.assumeVec(lv, vb);
+      s.setBlocked(lb);
+      result = s.assumpRARSolve();
+      const vec<Lit>& implied = s.getImplied();
+      for (int i=0; i<implied.size(); ++i) {
+         MA.set(win->ids[var(implied[i])], !sign(implied[i]));
+      }
+      s.assumeRelease();
+   }
+   else {
+      s.assumeRelease();
+      s.assumeVec(vv, vb);
+      s.setBlocked(blocked);
+      result = s.assumpRARSolve();
+      record_MA(s, MA);
+      s.assumeRelease();   // (the assignments are kept for the next query to reuse)
+   }
+   return result;
+}
+
+// Build the dominator tree of the reversed circuit, rooted at a virtual sink
+// fed by all POs, with the iterative algorithm of Cooper, Harvey and Kennedy.
+// _idom[g] is the immediate dominator of gate g on its paths to the POs
+// (_idom.size()-1 for the sink), or -1 if g reaches no PO
+void CirMgr::buildDomTree() {
+   int sink = GateMap.rbegin()->first + 1;
+   _idom.assign(sink + 1, -1);
+   _domPost.assign(sink + 1, -1);
+
+   // postorder of a DFS from the sink (0) through the fanins
+   vector<CirGate*> post;
+   vector<pair<CirGate*, int>> stack(1, pair<CirGate*, int>(0, 0));
+   vector<bool> visited(sink + 1, false);
+   while (!stack.empty()) {
+      CirGate* g = stack.back().first;
+      int k = stack.back().second++;
+      CirGate* c = 0;
+      if (!g) { if (k < int(_polist.size())) c = _polist[k]; }
+      else if (g->getTypeStr() == "Aig") c = k == 0? g->getFanin0(): k == 1? g->getFanin1(): 0;
+      else if (g->getTypeStr() == "Po") c = k == 0? g->getFanin0(): 0;
+      if (!c) {
+         _domPost[g? g->getID(): sink] = post.size();
+         post.push_back(g);
+         stack.pop_back();
+      }
+      else if (!visited[c->getID()]) {
+         visited[c->getID()] = true;
+         stack.push_back(pair<CirGate*, int>(c, 0));
+      }
+   }
+
+   // the predecessors of a gate in the reversed circuit are its fanouts
+   _idom[sink] = sink;
+   for (bool changed = true; changed; ) {
+      changed = false;
+      for (int i=int(post.size())-2; i>=0; --i) {
+         CirGate* g = post[i];
+         int d = -1;
+         if (g->getTypeStr() == "Po") d = sink;
+         else {
+            vector<CirGate*> fanout = g->getFanout();
+            for (size_t j=0; j<fanout.size(); ++j) {
+               int f = fanout[j]->getID();
+               if (_idom[f] == -1) continue;
+               if (d == -1) { d = f; continue; }
+               while (d != f) {
+                  while (_domPost[d] < _domPost[f]) d = _idom[d];
+                  while (_domPost[f] < _domPost[d]) f = _idom[f];
+               }
+            }
          }
-         findAllgd(GateMap[Id]->getFanout()[i]->getID(), gds, check_gd);
+         if (_idom[g->getID()] != d) { _idom[g->getID()] = d; changed = true; }
       }
    }
 }
 
-void CirMgr::satRAR() {
+// the AIG dominators Gd of gate "id" from the nearest one, as (Gd, 0 or 1) for
+// the side input fanin1 or fanin0 of Gd, or (Gd, 2) if both fanins are reached
+// from "id"; "region" is used to mark the gates between "id" and the last Gd
+void CirMgr::findDoms(int id, vector<pair<int, int>>& gds, RarMA& region) const {
+   int sink = _idom.size() - 1, last = -1;
+   gds.clear();
+   for (int d=_idom[id]; d>=0 && d!=sink; d=_idom[d]) {
+      if (GateMap.at(d)->getTypeStr() != "Aig") continue;
+      gds.push_back(pair<int, int>(d, 2));
+      last = d;
+   }
+   if (gds.empty()) return;
+
+   // every path from "id" to a PO passes the last Gd
+   region.clear();
+   region.set(id, 1);
+   vector<CirGate*> stack(1, GateMap.at(id));
+   while (!stack.empty()) {
+      CirGate* g = stack.back();
+      stack.pop_back();
+      if (g->getID() == last) continue;
+      vector<CirGate*> fanout = g->getFanout();
+      for (size_t j=0; j<fanout.size(); ++j) {
+         if (region[fanout[j]->getID()] != 2) continue;
+         region.set(fanout[j]->getID(), 1);
+         stack.push_back(fanout[j]);
+      }
+   }
+   for (size_t i=0; i<gds.size(); ++i) {
+      CirGate* g = GateMap.at(gds[i].first);
+      bool in0 = region[g->getFanin0()->getID()] != 2, in1 = region[g->getFanin1()->getID()] != 2;
+      gds[i].second = in0 && in1? 2: in0? 0: 1;
+   }
+   region.clear();
+}
+
+// representative of gate "id" in the union-find of CirMgr::probe(); "inv" is
+// set if "id" is the complement of it
+static int probeRep(const vector<int>& rep, const vector<bool>& repInv, int id, bool& inv) {
+   inv = false;
+   while (rep[id] != id) { inv ^= repInv[id]; id = rep[id]; }
+   return id;
+}
+
+// record a == b ^ inv; the gate earlier in "topo" stays the representative
+static void probeMerge(vector<int>& rep, vector<bool>& repInv, const vector<int>& topo, int a, int b, bool inv) {
+   bool ia, ib;
+   int ra = probeRep(rep, repInv, a, ia), rb = probeRep(rep, repInv, b, ib);
+   if (ra == rb) return;
+   if (topo[ra] > topo[rb]) swap(ra, rb);
+   rep[rb] = ra;
+   repInv[rb] = ia ^ ib ^ inv;
+}
+
+// Failed-literal probing on the CNF of the whole AIG. Every AIG gate found to
+// be constant or equivalent to another gate is merged into its representative
+// (CONST0 or the gate with the smallest topological order), so that later
+// commands (e.g. CIRSatRAR) have fewer gates to deal with
+void CirMgr::probe() {
+   int n = GateMap.empty()? 1: GateMap.rbegin()->first + 1;
+   vector<Gate*> gates;
+   SatSolver solver;
+   solver.initialize();
+   for (int i=0; i<n; ++i) {
+      gates.push_back(new Gate(i));
+   }
+   genAigModel(solver, gates, GateMap);
+   solver.assertProperty(gates[0]->getVar(), false);
+
+   vec<Lit> units, equivs;
+   bool ok = solver.probe(units, equivs);
+   for (size_t i=0; i<gates.size(); ++i) delete gates[i];
+   if (!ok) {
+      cerr << "Error: the CNF of the circuit is unsatisfiable!!" << endl;
+      return;
+   }
+
+   // topological order (fanins first); CONST0 comes first
+   vector<int> topo(n, -1);
+   vector<pair<CirGate*, bool> > stack;   // (gate, fanins already pushed)
+   int cnt = 0;
+   topo[0] = cnt++;
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      stack.push_back(pair<CirGate*, bool>(it->second, false));
+      while (!stack.empty()) {
+         CirGate* g = stack.back().first;
+         bool expanded = stack.back().second;
+         stack.pop_back();
+         if (topo[g->getID()] >= 0) continue;
+         if (expanded || g->getTypeStr() != "Aig") { topo[g->getID()] = cnt++; continue; }
+         stack.push_back(pair<CirGate*, bool>(g, true));
+         stack.push_back(pair<CirGate*, bool>(g->getFanin0(), false));
+         stack.push_back(pair<CirGate*, bool>(g->getFanin1(), false));
+      }
+   }
+
+   vector<int> rep(n);
+   vector<bool> repInv(n, false);
+   for (int i=0; i<n; ++i) rep[i] = i;
+   for (int i=0; i<units.size(); ++i) {
+      if (var(units[i]) != 0) probeMerge(rep, repInv, topo, 0, var(units[i]), !sign(units[i]));
+   }
+   for (int i=0; i<equivs.size(); i+=2) {
+      probeMerge(rep, repInv, topo, var(equivs[i]), var(equivs[i+1]), sign(equivs[i]) ^ sign(equivs[i+1]));
+   }
+
+   // move the fanouts of each merged AIG gate to its representative
+   vector<CirGate*> merged;
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      bool inv;
+      int r = probeRep(rep, repInv, it->first, inv);
+      CirGate* g = it->second;
+      if (r == it->first || g->getTypeStr() != "Aig") continue;
+      CirGate* rg = r? GateMap[r]: const0;
+      cout << "Probe: " << r << " merging " << (inv? "!": "") << it->first << "..." << endl;
+      vector<CirGate*> fanout = g->getFanout();
+      for (size_t j=0; j<fanout.size(); ++j) {
+         CirGate* h = fanout[j];
+         if (h->getFanin0() == g) { h->setFanin0(rg, h->getInv0() ^ inv); rg->pushFanout(h); }
+         if (h->getFanin1() == g) { h->setFanin1(rg, h->getInv1() ^ inv); rg->pushFanout(h); }
+      }
+      merged.push_back(g);
+   }
+   for (size_t i=0; i<merged.size(); ++i) {
+      merged[i]->getFanin0()->removeFanout(merged[i]);
+      merged[i]->getFanin1()->removeFanout(merged[i]);
+      GateMap.erase(merged[i]->getID());
+      _aiglist.erase(find(_aiglist.begin(), _aiglist.end(), merged[i]));
+      delete merged[i];
+   }
+}
+
+// Random simulation of the netlist, 64 patterns per word, indexed by gate ID
+class RarSim
+{
+public:
+   static const int WORDS = 4;
+
+   void simulate(const map<int, CirGate*>& gateMap, unsigned seed);
+   // the patterns with gate vv[i] == vb[i] for every i
+   void match(const vector<Var>& vv, const vector<bool>& vb, uint64_t* mask) const {
+      for (int w=0; w<WORDS; ++w) mask[w] = ~uint64_t(0);
+      for (size_t i=0; i<vv.size(); ++i) {
+         for (int w=0; w<WORDS; ++w) mask[w] &= vb[i]? word(vv[i], w): ~word(vv[i], w);
+      }
+   }
+   uint64_t word(unsigned id, int w) const { return _sig[id * WORDS + w]; }
+
+private:
+   vector<uint64_t>  _sig;
+};
+
+// the gates of "gateMap" with the fanins of every AIG gate before it
+static void rarTopoOrder(const map<int, CirGate*>& gateMap, vector<CirGate*>& order) {
+   vector<bool> done(gateMap.rbegin()->first + 1, false);
+   order.clear();
+   for (auto it=gateMap.begin(); it!=gateMap.end(); ++it) {
+      vector<pair<CirGate*, bool>> stack(1, pair<CirGate*, bool>(it->second, false));
+      while (!stack.empty()) {
+         CirGate* g = stack.back().first;
+         bool expanded = stack.back().second;
+         stack.pop_back();
+         if (done[g->getID()]) continue;
+         if (g->getTypeStr() == "Aig" && !expanded) {
+            stack.push_back(pair<CirGate*, bool>(g, true));
+            stack.push_back(pair<CirGate*, bool>(g->getFanin0(), false));
+            stack.push_back(pair<CirGate*, bool>(g->getFanin1(), false));
+            continue;
+         }
+         done[g->getID()] = true;
+         order.push_back(g);
+      }
+   }
+}
+
+void RarSim::simulate(const map<int, CirGate*>& gateMap, unsigned seed) {
+   RandomNumGen rn(seed);
+   _sig.assign((gateMap.rbegin()->first + 1) * WORDS, 0);   // CONST0 and UNDEF gates stay 0
+   vector<CirGate*> order;
+   rarTopoOrder(gateMap, order);
+   for (size_t i=0; i<order.size(); ++i) {
+      CirGate* g = order[i];
+      uint64_t* s = &_sig[g->getID() * WORDS];
+      if (g->getTypeStr() == "Pi") {
+         for (int w=0; w<WORDS; ++w) {
+            for (int k=0; k<4; ++k) s[w] = (s[w] << 16) | uint64_t(rn(1 << 16) & 0xffff);
+         }
+      }
+      else if (g->getTypeStr() == "Aig") {
+         unsigned f0 = g->getFanin0()->getID(), f1 = g->getFanin1()->getID();
+         uint64_t i0 = g->getInv0()? ~uint64_t(0): 0, i1 = g->getInv1()? ~uint64_t(0): 0;
+         for (int w=0; w<WORDS; ++w) s[w] = (word(f0, w) ^ i0) & (word(f1, w) ^ i1);
+      }
+   }
+}
+
+// True if the patterns of "sim" show that the candidate query vv = vb (Gd,
+// candidate "src" and the side inputs) of target "id" gives no alternative:
+// BCP only implies values that hold in every pattern satisfying vv = vb, so
+// with such a pattern there is no conflict, and a gate of "wtGates" with a
+// pattern where it has its MA_wt value is not implied to the other value.
+// The scan starts at "hint", the gate that stopped the previous scan.
+static bool rarSimRefutes(const RarSim& sim, const vector<Var>& vv, const vector<bool>& vb,
+                          int id, int src, const vector<int>& wtGates, const RarMA& MA_wt,
+                          size_t& hint) {
+   uint64_t mask[RarSim::WORDS], any = 0;
+   sim.match(vv, vb, mask);
+   for (int w=0; w<RarSim::WORDS; ++w) any |= mask[w];
+   if (!any) return false;
+   if (src == id) return true;   // (no alternative gate with the target)
+   size_t n = wtGates.size();
+   if (hint >= n) hint = 0;
+   for (size_t k=0; k<n; ++k) {
+      size_t i = hint + k < n? hint + k: hint + k - n;
+      if (wtGates[i] == id) continue;
+      uint64_t witness = 0;
+      for (int w=0; w<RarSim::WORDS; ++w) {
+         uint64_t s = sim.word(wtGates[i], w);
+         witness |= mask[w] & (MA_wt[wtGates[i]]? s: ~s);
+      }
+      if (!witness) { hint = i; return false; }
+   }
+   return true;
+}
+
+// An alternative found for a target: wire "src -> gd" (src2 < 0) or
+// gate "src & src2 -> gd"; val/val2 are the MAs of src/src2 for the target
+struct RarAlt
+{
+   RarAlt(int s, bool v, int s2, bool v2, int g, int s3 = -1, bool v3 = false):
+      src(s), src2(s2), src3(s3), gd(g), val(v), val2(v2), val3(v3) {}
+   int   src, src2, src3, gd;
+   bool  val, val2, val3;
+};
+
+// Set of the gates of a target's wtGates, bit i for wtGates[i]
+typedef vector<uint64_t> RarBits;
+
+// Why the analysis of a target ended, for the budgets of CIRSatRAR
+enum RarStop
+{
+   RAR_DONE    = 0,
+   RAR_TIMEOUT = 1,   // -TImeout reached (before or during the target)
+   RAR_BUDGET  = 2,   // -Budget propagations used up
+   RAR_CANDS   = 3,   // -MAXCands candidate queries made
+   RAR_TOP     = 4,   // -Top targets with alternatives found before it
+
+   RAR_TOT_STOP
+};
+
+// Per-thread state of CIRSatRAR. The solver is a copy of the master solver
+// that each target puts back to the state of the master (see rarTarget()), so
+// its alternatives do not depend on the targets analyzed before it, nor on the
+// thread that analyzes it; the implication cache is kept. With -Lazy the
+// solver is kept and grows instead; where RARSolve leaves the watches then
+// depends on the earlier targets, and with blocked gates so can its MAs
+// (hence -Lazy runs on one thread only)
+struct RarWorker
+{
+   RarWorker(const SatSolver& m, const CirImp& i, const RarSim& s, const vector<Gate*>& g):
+      solver(new SatSolver(m)), imp(i), sim(s), gates(g), MA_wt(g.size()), MA_gd(g.size()),
+      check_gd(g.size()), MA_q(g.size()), win(g.size()), wtIdx(g.size(), -1), simHint(0),
+      nQuery(0), nSimSkip(0), nWinGates(0), nMulti(0), multiTime(0) { }
+   ~RarWorker() { delete solver; }
+   bool budgetOut() const { return solver->RARBudgetOut() || imp.budgetOut(); }
+
+   SatSolver*              solver;
+   CirImp                  imp;
+   const RarSim&           sim;
+   const vector<Gate*>&    gates;
+   RarMA                   MA_wt, MA_gd, check_gd, MA_q;
+   RarWindow               win;                // of the current target with -Window; encoded with -Lazy
+   vector<int>             wtGates;            // gates of MA_wt, in the order of IDs
+   vector<int>             wtIdx;              // gate ID -> index in wtGates, -1 elsewhere
+   RarBits                 wtOne;              // wtGates with MA_wt 1
+   RarBits                 bitsA, bitsV;       // for rarDiffGate()
+   size_t                  simHint;            // for rarSimRefutes()
+   size_t                  nQuery, nSimSkip;   // candidate queries, skipped by simulation
+   size_t                  nWinGates;          // window sizes summed over the targets
+   size_t                  nMulti;             // alternatives found by rarMulti()
+   double                  multiTime;          // seconds spent in rarMulti()
+};
+
+// The first gate of w.wtGates, other than id, s1 and s2, that MA assigns the
+// other value than MA_wt does; -1 if none. With A the gates assigned by MA and
+// V those assigned 1, the candidates are A & (V ^ wtOne), a word at a time
+static int rarDiffGate(RarWorker& w, const RarMA& MA, int id, int s1, int s2) {
+   size_t nw = w.wtOne.size();
+   w.bitsA.assign(nw, 0);
+   w.bitsV.assign(nw, 0);
+   const vector<unsigned>& touched = MA.touched();
+   for (size_t i=0; i<touched.size(); ++i) {
+      int k = w.wtIdx[touched[i]];
+      if (k < 0 || MA[touched[i]] == 2) continue;
+      w.bitsA[k >> 6] |= uint64_t(1) << (k & 63);
+      if (MA[touched[i]] == 1) w.bitsV[k >> 6] |= uint64_t(1) << (k & 63);
+   }
+   int skip[3] = { id, s1, s2 };
+   for (int j=0; j<3; ++j) {
+      int k = skip[j] >= 0? w.wtIdx[skip[j]]: -1;
+      if (k >= 0) w.bitsA[k >> 6] &= ~(uint64_t(1) << (k & 63));
+   }
+   for (size_t i=0; i<nw; ++i) {
+      uint64_t d = w.bitsA[i] & (w.bitsV[i] ^ w.wtOne[i]);
+      if (!d) continue;
+      int k = i << 6;
+      while (!(d & 1)) { d >>= 1; ++k; }
+      return w.wtGates[k];
+   }
+   return -1;
+}
+
+// Targets of CIRSatRAR shared by the worker threads. The targets are dealt out
+// in contiguous blocks; a worker takes the targets of its own queue from the
+// front, and steals from the back of the others' queues when it runs dry.
+// If "ordered", all workers take from the front of a single queue instead, so
+// the targets are started in priority order
+struct RarPool
+{
+   RarPool(const vector<int>& t, unsigned n, bool ordered):
+      targets(t), queues(ordered? 1: n), locks(queues.size()), alts(t.size()),
+      stops(t.size(), RAR_DONE), queries(t.size(), 0), times(t.size(), 0), cached(t.size(), 0),
+      done(t.size(), 0), nFound(0), nDone(0),
+      nextProgress(chrono::steady_clock::now() + chrono::seconds(1)) {
+      for (size_t i=0; i<t.size(); ++i) queues[i * queues.size() / t.size()].push_back(i);
+   }
+   // get the index of the next target for worker k, and nFound as it was when
+   // the target was taken (so not counting the targets taken after it);
+   // false if none is left
+   bool next(unsigned k, size_t& i, unsigned& found) {
+      for (size_t j=0; j<queues.size(); ++j) {
+         size_t q = (k + j) % queues.size();
+         lock_guard<mutex> lock(locks[q]);
+         if (queues[q].empty()) continue;
+         if (j == 0) { i = queues[q].front(); queues[q].pop_front(); }
+         else { i = queues[q].back(); queues[q].pop_back(); }
+         found = nFound;
+         return true;
+      }
+      return false;
+   }
+
+   const vector<int>&         targets;
+   vector<deque<size_t>>      queues;
+   vector<mutex>              locks;
+   vector<vector<RarAlt>>     alts;    // alternatives of targets[i]
+   vector<char>               stops;   // RarStop of targets[i]
+   vector<unsigned>           queries; // candidate queries of targets[i]
+   vector<double>             times;   // seconds spent on targets[i]
+   vector<char>               cached;  // targets[i] taken from CirMgr::_rarCache
+   vector<char>               done;    // -CHeckpoint: targets[i] finished (under saveLock)
+   atomic<unsigned>           nFound;  // targets with alternatives so far
+   atomic<size_t>             nDone;   // targets finished so far
+   mutex                      progressLock, saveLock;
+   chrono::steady_clock::time_point  nextProgress;   // of rarProgress()
+};
+
+static const char* rarStopStr[RAR_TOT_STOP] = { "done", "timeout", "budget", "cands", "top" };
+
+// the RarRecords of targets[i] of "pool" for analysis round "round": one per
+// alternative, or one for the target if it has none
+static void rarRecords(const RarPool& pool, size_t i, unsigned round, vector<RarRecord>& recs) {
+   RarRecord r;
+   r.round = round;
+   r.target = pool.targets[i];
+   r.queries = pool.queries[i];
+   r.seconds = pool.times[i];
+   r.stop = pool.stops[i];
+   if (pool.alts[i].empty()) recs.push_back(r);
+   for (size_t j=0; j<pool.alts[i].size(); ++j) {
+      const RarAlt& alt = pool.alts[i][j];
+      r.gd = alt.gd;
+      r.src[0] = alt.src; r.src[1] = alt.src2; r.src[2] = alt.src3;
+      r.val[0] = alt.val; r.val[1] = alt.val2; r.val[2] = alt.val3;
+      recs.push_back(r);
+   }
+}
+
+// the targets stopped by -TImeout or -TOp are to be analyzed again
+static bool rarFinished(int stop) { return stop != RAR_TIMEOUT && stop != RAR_TOP; }
+
+// -CHeckpoint: the least seconds between two saves during the analysis; it
+// grows to RAR_SAVE_RATIO times the time of the last save
+static const unsigned RAR_SAVE_SEC = 60;
+static const unsigned RAR_SAVE_RATIO = 50;
+
+void CirMgr::satRAR(const RarOption& opt) {
+
+   _rarOpt = opt;
+   _rarStart = chrono::steady_clock::now();
+   _rarDeadline = _rarStart + chrono::seconds(_rarOpt.timeout);
+   _rarUntried = 0;
+   _rarStops.assign(RAR_TOT_STOP, 0);
+   _rarRound = 0;
+   _rarResults.clear();
+   _rarReused = 0;
+   _rarApplied = 0;
+   _rarAig0 = _aiglist.size();
+   _rarNetlist0.clear();
+   if (_rarOpt.apply && !_rarOpt.checkpoint.empty()) {
+      stringstream aag;
+      writeAag(aag);
+      _rarNetlist0 = aag.str();
+   }
+   _rarNextSave = _rarStart + chrono::seconds(RAR_SAVE_SEC);
+   if (_rarOpt.resume) rarRestore(*_rarOpt.resume);
+   if (_rarOpt.apply) {
+      rarApply();
+      if (_rarOpt.out) rarWriteResults(*_rarOpt.out, _rarOpt.csv);
+      return;
+   }
+
+   vector<int> targets;
+   vector<vector<RarAlt>> alts;
+   rarAnalyze(targets, alts);
+
+   // report in the order of the targets
+   int count_tar = 0, count_alt = 0;
+   for (size_t i=0; i<targets.size(); ++i) {
+      count_tar ++;
+      if (_rarOpt.out) { count_alt += alts[i].size(); continue; }
+      cout << "id: " << targets[i] << " count_tar: " << count_tar << "\n";
+      for (size_t j=0; j<alts[i].size(); ++j) {
+         const RarAlt& alt = alts[i][j];
+         if (alt.src2 < 0)
+            cout << "alternative wire: " << alt.src << " -> " << alt.gd << "  " << count_alt << "\n";
+         else if (alt.src3 < 0)
+            cout << "alternative gate: " << alt.src << " & " << alt.src2 << " -> " << alt.gd << "\n";
+         else
+            cout << "alternative multi-gate: " << alt.src << " & " << alt.src2 << " & " << alt.src3
+                 << " -> " << alt.gd << "\n";
+         count_alt ++;
+      }
+   }
+
+   cout << "#tar: " << count_tar << " #alt: " << count_alt << "\n";
+   cout << "#query: " << _rarQueries << " #sim-skip: " << _rarSimSkips << "\n";
+   if (_rarOpt.multi)
+      cout << "#multi: " << _rarMulti << " alternatives in " << _rarMultiTime << " s\n";
+   if (_rarOpt.window && !targets.empty())
+      cout << "#window: " << _rarOpt.window << " levels, " << _rarWinGates / targets.size()
+           << " gates on average\n";
+   rarReportStops();
+   if (_rarOpt.out) {
+      rarWriteResults(*_rarOpt.out, _rarOpt.csv);
+      cout << "#output: " << _rarResults.size() << " records\n";
+   }
+}
+
+// true once the -TImeout of the current CIRSatRAR has passed
+bool CirMgr::rarTimedOut() const {
+   // (the comparison operators of time_point clash with the ones of MiniSat)
+   return _rarOpt.timeout && (chrono::steady_clock::now() - _rarDeadline).count() >= 0;
+}
+
+// summary of the targets skipped or cut short by the budgets, if any
+void CirMgr::rarReportStops() const {
+   if (!_rarUntried && !_rarStops[RAR_TIMEOUT] && !_rarStops[RAR_BUDGET] && !_rarStops[RAR_CANDS]
+       && !_rarStops[RAR_TOP])
+      return;
+   cout << "#skip: " << _rarUntried << " over -MAXTargets, " << _rarStops[RAR_TIMEOUT]
+        << " timed out, " << _rarStops[RAR_BUDGET] << " out of -Budget, "
+        << _rarStops[RAR_CANDS] << " cut at -MAXCands, " << _rarStops[RAR_TOP] << " after -Top\n";
+}
+
+// -OUtput: print a summary of "pool" on the console, at most once a second
+void CirMgr::rarProgress(RarPool& pool) const {
+   chrono::steady_clock::time_point now = chrono::steady_clock::now();
+   lock_guard<mutex> lock(pool.progressLock);
+   if ((now - pool.nextProgress).count() < 0) return;
+   pool.nextProgress = now + chrono::seconds(1);
+   cout << "#progress: round " << _rarRound + 1 << ", " << pool.nDone << "/" << pool.targets.size()
+        << " targets, " << pool.nFound << " with alternatives, "
+        << chrono::duration<double>(now - _rarStart).count() << " s" << endl;
+}
+
+// write _rarResults to "os", one line per record, as CSV (with a header line)
+// or JSON Lines
+void CirMgr::rarWriteResults(ostream& os, bool csv) const {
+   if (csv)
+      os << "round,target,type,gd,src1,val1,src2,val2,src3,val3,queries,time_us,query_us,stop,applied,cached\n";
+   for (size_t i=0; i<_rarResults.size(); ++i) {
+      const RarRecord& r = _rarResults[i];
+      double us = r.seconds * 1e6, qus = r.queries? us / r.queries: 0;
+      if (csv) {
+         os << r.round << "," << r.target << "," << r.type() << ",";
+         if (r.gd >= 0) os << r.gd;
+         for (int k=0; k<3; ++k) {
+            if (r.src[k] >= 0) os << "," << r.src[k] << "," << r.val[k];
+            else os << ",,";
+         }
+         os << "," << r.queries << "," << us << "," << qus << "," << rarStopStr[r.stop]
+            << "," << r.applied << "," << r.cached << "\n";
+         continue;
+      }
+      os << "{\"round\":" << r.round << ",\"target\":" << r.target << ",\"type\":\"" << r.type()
+         << "\",\"gd\":";
+      if (r.gd >= 0) os << r.gd;
+      else os << "null";
+      os << ",\"src\":[";
+      for (int k=0; k<3 && r.src[k] >= 0; ++k) os << (k? ",": "") << r.src[k];
+      os << "],\"val\":[";
+      for (int k=0; k<3 && r.src[k] >= 0; ++k) os << (k? ",": "") << r.val[k];
+      os << "],\"queries\":" << r.queries << ",\"time_us\":" << us << ",\"query_us\":" << qus
+         << ",\"stop\":\"" << rarStopStr[r.stop] << "\",\"applied\":" << (r.applied? "true": "false")
+         << ",\"cached\":" << (r.cached? "true": "false")
+         << "}\n";
+   }
+   os.flush();
+}
+
+// -CHeckpoint: save the state of the run. With "pool", the current round is
+// being analyzed, and its targets finished so far are saved as done
+void CirMgr::rarSave(const RarPool* pool) const {
+   RarCheckpoint ck;
+   ck.opt = _rarOpt;
+   stringstream aag;
+   writeAag(aag);
+   ck.netlist = aag.str();
+   ck.round = _rarRound;
+   ck.applied = _rarApplied;
+   ck.aig = _rarAig0;
+   ck.original = _rarNetlist0;
+   ck.rejected = _rarRejected;
+   ck.results = _rarResults;
+   ck.done = _rarCache;
+   for (size_t i=0; pool && i<pool->targets.size(); ++i) {
+      if (!pool->done[i] || pool->cached[i] || !rarFinished(pool->stops[i])) continue;
+      size_t t = pool->targets[i];
+      if (ck.done.size() <= t) ck.done.resize(t + 1);
+      rarRecords(*pool, i, _rarRound + 1, ck.done[t]);
+      for (size_t j=0; j<ck.done[t].size(); ++j) ck.done[t][j].cached = true;
+   }
+   if (!ck.write(_rarOpt.checkpoint))
+      cerr << "Error: cannot write checkpoint \"" << _rarOpt.checkpoint << "\"!!" << endl;
+}
+
+// -CHeckpoint, by the worker that finished targets[i] of "pool": save once
+// the interval is over, so that saving takes under 1/RAR_SAVE_RATIO of the run
+void CirMgr::rarSaveDue(RarPool& pool, size_t i) {
+   lock_guard<mutex> lock(pool.saveLock);
+   pool.done[i] = 1;
+   chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+   if ((t0 - _rarNextSave).count() < 0) return;
+   rarSave(&pool);
+   chrono::steady_clock::duration t = chrono::steady_clock::now() - t0;
+   if ((t * RAR_SAVE_RATIO - chrono::seconds(RAR_SAVE_SEC)).count() > 0)
+      _rarNextSave = t0 + t * (RAR_SAVE_RATIO + 1);
+   else _rarNextSave = t0 + t + chrono::seconds(RAR_SAVE_SEC);
+}
+
+// -Resume: continue from "ck" (the netlist is already that of "ck")
+void CirMgr::rarRestore(const RarCheckpoint& ck) {
+   _rarRound = ck.round;
+   _rarApplied = ck.applied;
+   _rarAig0 = ck.aig;
+   _rarNetlist0 = ck.original;
+   _rarRejected = ck.rejected;
+   _rarResults = ck.results;
+   _rarCache = ck.done;
+   size_t n = 0;
+   for (size_t t=0; t<_rarCache.size(); ++t) n += !_rarCache[t].empty();
+   cout << "#resume: round " << _rarRound + 1 << ", " << n << " targets done\n";
+}
+
+// find the alternatives alts[i] of every AIG gate targets[i] of the netlist
+void CirMgr::rarAnalyze(vector<int>& targets, vector<vector<RarAlt>>& alts) {
 
    // write aig circuit into cnf 
    vector<Gate* > gates;
-   vector<pair<int,int>> gds1, gds2, gds3, gds4;
-   map<int, int> MA_wt, MA_gd, MA_wt2, check_gd; // MA_wt2 for the second decision
-   bool result_wt = true, result_gd = true, isConflict = false, result_wt2;
    SatSolver solver;
+   CirImp imp;
    solver.initialize();
 
-   for(int i=0; i<GateMap.size()+1; ++i) {
+   // (IDs may have gaps, e.g. after CIRProbe)
+   for(int i=0; i<GateMap.rbegin()->first+1; ++i) {
       gates.push_back(new Gate(i));
    }
-   genAigModel(solver, gates, GateMap);
-
-   for (auto it=GateMap.begin();it!=GateMap.end();++it){
-      MA_gd[it->first] = 2;
-      MA_wt[it->first] = 2;
-      MA_wt2[it->first] = 2;
-      check_gd[it->first] = 2;
+   if (_rarOpt.aigImp) {
+      // no CNF needed; same Var (== gate ID) as genAigModel would give
+      for (size_t i=0; i<gates.size(); ++i) gates[i]->setVar(i);
+      imp.build(GateMap);
    }
+   else if (_rarOpt.lazyCnf || _rarOpt.window) {
+      // each worker has a solver of its own, on local Vars (see RarWindow)
+      for (size_t i=0; i<gates.size(); ++i) gates[i]->setVar(i);
+   }
+   else genAigModel(solver, gates, GateMap);
+   buildDomTree();
+   RarSim sim;
+   if (_rarOpt.simFilter) sim.simulate(GateMap, 1);
 
    // Clear assumptions
    solver.assumeRelease();  
 
-   int count_tar = 0, count_alt = 0;
+   targets.clear();
+   for (auto itt=GateMap.begin();itt!=GateMap.end();++itt){
+      if(itt->second->getTypeStr() == "Aig" && !itt->second->getFanout().empty()
+         && !(size_t(itt->first) < _rarRejected.size() && _rarRejected[itt->first]))
+         targets.push_back(itt->first);
+   }
+   rarOrder(targets);
+   if (_rarOpt.maxTargets && targets.size() > _rarOpt.maxTargets) {
+      _rarUntried += targets.size() - _rarOpt.maxTargets;
+      targets.resize(_rarOpt.maxTargets);
+   }
+
+   // the targets are independent; analyze them with _rarOpt.threads workers
+   unsigned nThreads = _rarOpt.threads;
+   if (nThreads > targets.size()) nThreads = targets.size();
+   if (nThreads == 0) nThreads = 1;
+   RarPool pool(targets, nThreads, _rarOpt.order != RAR_ORDER_ID || _rarOpt.top);
+   vector<RarWorker*> workers;
+   for (unsigned k=0; k<nThreads; ++k) {
+      workers.push_back(new RarWorker(solver, imp, sim, gates));
+      if (!_rarOpt.lazyCnf && !_rarOpt.window) workers[k]->solver->setRARBase(solver);
+   }
+   if (nThreads == 1) rarWork(*workers[0], pool, 0);
+   else {
+      vector<thread> threads;
+      for (unsigned k=0; k<nThreads; ++k) {
+         threads.push_back(thread(&CirMgr::rarWork, this, ref(*workers[k]), ref(pool), k));
+      }
+      for (unsigned k=0; k<nThreads; ++k) threads[k].join();
+   }
+   _rarQueries = _rarSimSkips = _rarWinGates = _rarMulti = 0;
+   _rarMultiTime = 0;
+   for (unsigned k=0; k<nThreads; ++k) {
+      _rarMulti += workers[k]->nMulti;
+      _rarMultiTime += workers[k]->multiTime;
+      _rarQueries += workers[k]->nQuery;
+      _rarSimSkips += workers[k]->nSimSkip;
+      _rarWinGates += workers[k]->nWinGates;
+      delete workers[k];
+   }
+   for (size_t i=0; i<gates.size(); ++i) delete gates[i];
+   if (_rarOpt.top) {
+      // the targets are started in order, so all those before the -Top'th one
+      // with alternatives are done; drop the few finished after it (a cached
+      // one gets the single record of a cut target, and keeps its cache)
+      unsigned n = 0;
+      for (size_t i=0; i<targets.size(); ++i) {
+         if (n == _rarOpt.top) { pool.alts[i].clear(); pool.stops[i] = RAR_TOP; pool.cached[i] = 0; }
+         else if (!pool.alts[i].empty()) ++n;
+      }
+   }
+   for (size_t i=0; i<targets.size(); ++i) {
+      ++_rarStops[pool.stops[i]];
+      _rarReused += pool.cached[i];
+   }
+
+   // (-APply saves once the round is committed)
+   if (!_rarOpt.checkpoint.empty() && !_rarOpt.apply) rarSave(&pool);
+
+   // the records of this round: one per alternative, or one per target without
+   ++_rarRound;
+   for (size_t i=0; i<targets.size(); ++i) {
+      if (pool.cached[i]) {
+         vector<RarRecord>& c = _rarCache[targets[i]];
+         for (size_t j=0; j<c.size(); ++j) {
+            c[j].round = _rarRound;
+            _rarResults.push_back(c[j]);
+         }
+         continue;
+      }
+      size_t k = _rarResults.size();
+      rarRecords(pool, i, _rarRound, _rarResults);
+      // the targets analyzed to the end are kept for the next rounds of -APply
+      if (!_rarOpt.apply || !rarFinished(pool.stops[i])) continue;
+      if (_rarCache.size() <= size_t(targets[i])) _rarCache.resize(targets[i] + 1);
+      _rarCache[targets[i]].assign(_rarResults.begin() + k, _rarResults.end());
+      for (size_t j=0; j<_rarCache[targets[i]].size(); ++j) _rarCache[targets[i]][j].cached = true;
+   }
+   alts.swap(pool.alts);
+}
+
+// worker "k" of satRAR(): analyze the targets of "pool" until none is left
+void CirMgr::rarWork(RarWorker& w, RarPool& pool, unsigned k) {
+   size_t i;
+   unsigned found;
+   while (pool.next(k, i, found)) {
+      if (rarTimedOut()) pool.stops[i] = RAR_TIMEOUT;
+      else if (_rarOpt.top && found >= _rarOpt.top) pool.stops[i] = RAR_TOP;
+      else if (size_t(pool.targets[i]) < _rarCache.size() && !_rarCache[pool.targets[i]].empty()) {
+         // unchanged since it was analyzed (see rarInvalidate())
+         const vector<RarRecord>& c = _rarCache[pool.targets[i]];
+         for (size_t j=0; j<c.size(); ++j) {
+            if (c[j].gd < 0) continue;
+            pool.alts[i].push_back(RarAlt(c[j].src[0], c[j].val[0], c[j].src[1], c[j].val[1], c[j].gd,
+                                          c[j].src[2], c[j].val[2]));
+         }
+         pool.stops[i] = c[0].stop;
+         pool.cached[i] = 1;
+         if (!pool.alts[i].empty()) ++pool.nFound;
+      }
+      else {
+         chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+         size_t q0 = w.nQuery;
+         pool.stops[i] = rarTarget(w, pool.targets[i], pool.alts[i]);
+         pool.times[i] = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+         pool.queries[i] = w.nQuery - q0;
+         if (!pool.alts[i].empty()) ++pool.nFound;
+      }
+      ++pool.nDone;
+      if (_rarOpt.out) rarProgress(pool);
+      if (!_rarOpt.checkpoint.empty()) rarSaveDue(pool, i);
+   }
+}
+
+// find the alternatives of target "id" with the solver/CirImp of "w";
+// return the RarStop (the alternatives found before a stop are kept)
+int CirMgr::rarTarget(RarWorker& w, int id, vector<RarAlt>& alts) {
+
+   vector<pair<int,int>> gds1;
+   RarMA& MA_wt = w.MA_wt;
+   RarMA& MA_gd = w.MA_gd;
+   RarMA& MA_q = w.MA_q;
+   RarMA& check_gd = w.check_gd;
+   const vector<Gate*>& gates = w.gates;
+   bool result_wt = true, result_gd = true;
    vector<int> fanout;
    vector<Var> vv;
    vector<bool> vb;
    bool findwire = false, findgate = false;
-   // make assumptions
-   int id;
-   int test = 0;
+   unsigned nCands = 0;
+   MA_wt.clear();
+   MA_gd.clear();
+
+   // every target starts from the same solver state, but with -Lazy: the
+   // solver of the worker keeps the cones of its earlier targets
+   if (_rarOpt.window) {
+      delete w.solver;
+      w.solver = rarWindow(w.win, id);
+      w.nWinGates += w.win.ids.size();
+   }
+   else if (_rarOpt.lazyCnf) rarLazy(w.win, *w.solver, id);
+   else w.solver->restoreRAR();
+   SatSolver& solver = *w.solver;
+   CirImp& imp = w.imp;
+   solver.setRARBudget(_rarOpt.maxProps? (int64)_rarOpt.maxProps: -1);
+   imp.setBudget(_rarOpt.maxProps? (long long)_rarOpt.maxProps: -1);
+
+   vv.push_back(gates[id]->getVar());
+   vb.push_back(true);
+
+   MA_wt.set(gates[id]->getVar(), true);
+
+   // Gds: the dominators of the target
+   findDoms(id, gds1, check_gd);
+   if (_rarOpt.window) {
+      // (only the Gds within the window)
+      size_t n = 0;
+      for (size_t i=0; i<gds1.size(); ++i) {
+         if (w.win.tfo[gds1[i].first]) gds1[n++] = gds1[i];
+      }
+      gds1.resize(n);
+   }
+   const RarWindow* win = _rarOpt.window || _rarOpt.lazyCnf? &w.win: 0;
 
-   cout << GateMap.size() << "\n";
+   // for (size_t k=0; k<gds1.size(); k++) {
+   //    cout << "  gds  " << gds1[k].first << "\n";
+   // }
 
-   for (auto itt=GateMap.begin();itt!=GateMap.end();++itt){
-      
-      // cout << "type: " << itt->second->getTypeStr() << "\n";
 
-      if(itt->second->getTypeStr() == "Aig") {
+   for (size_t i=0; i<gds1.size(); ++i) {
+      fanout.push_back(gds1[i].first);
+   }
+   
 
-         // for (size_t l=0; l<itt->second->getFanout().size(); l++) {
-         //    if(itt->second->getFanout()[l]->getTypeStr() == "PO") {
+   // excitation
 
-         //    }
-         // }
+   for (auto it2=gds1.begin(); it2!=gds1.end(); it2++) {
+      if (it2->second == 2) continue;   // no side input
+      if (it2->second == 1) {
+         vv.push_back(gates[GateMap.at(it2->first)->getFanin0()->getID()]->getVar());
+         if (GateMap.at(it2->first)->getInv0()) vb.push_back(false);
+         else vb.push_back(true);
 
-         fanout.clear();
-         gds1.clear();
-         gds2.clear();
-         vv.clear();
-         vb.clear();
-         clear_MA(MA_wt);
+      } else {
+         vv.push_back(gates[GateMap.at(it2->first)->getFanin1()->getID()]->getVar());
+         if (GateMap.at(it2->first)->getInv1()) vb.push_back(false);
+         else vb.push_back(true);
+      }
 
-         id = itt->first;
-         count_tar ++;
-         cout << "id: " << id << " count_tar: " << count_tar << "\n";
-      
-         vv.push_back(gates[id]->getVar());
-         vb.push_back(true);
+      MA_wt.set(vv[vv.size()-1], vb[vb.size()-1]);
+   }
 
-         MA_wt[gates[id]->getVar()] = true;
+   // for (size_t j=0; j<vv.size(); j++) {
+   //    cout << vv[j] << "  " << vb[j] << "\n";
+   // }
 
-         auto it = GateMap[id];
-         // find all fanout
-         
+   // cout << gds1.size() << "   " <<  vv.size() << "   " << vb.size() << "\n";
+
+   result_wt = rarImply(solver, imp, vv, vb, fanout, MA_wt, win);
+   if (w.budgetOut()) return RAR_BUDGET;
+   // the gates assigned by the Wt query, in the order of GateMap
+   vector<int>& wtGates = w.wtGates;
+   for (size_t i=0; i<wtGates.size(); ++i) w.wtIdx[wtGates[i]] = -1;
+   wtGates.clear();
+   for (size_t i=0; i<MA_wt.touched().size(); ++i) {
+      if (GateMap.count(MA_wt.touched()[i])) wtGates.push_back(MA_wt.touched()[i]);
+   }
+   sort(wtGates.begin(), wtGates.end());
+   w.wtOne.assign((wtGates.size() + 63) / 64, 0);
+   for (size_t i=0; i<wtGates.size(); ++i) {
+      w.wtIdx[wtGates[i]] = i;
+      if (MA_wt[wtGates[i]] == 1) w.wtOne[i >> 6] |= uint64_t(1) << (i & 63);
+   }
+   // the excitation (the side inputs of the Gds), for rarMulti()
+   vector<Var> excV(vv.begin() + 1, vv.end());
+   vector<bool> excB(vb.begin() + 1, vb.end());
+   // for (auto it2=GateMap.begin();it2!=GateMap.end();++it2){
+   //    cout << "id: " << it2->first << " value: " << MA_wt[it2->first] << "\n";
+   // }
+
+   // cout << (result_wt? "SAT" : "UNSAT") << endl;
+
+   vv.clear();
+   vb.clear();
+
+   // for each Gd
+   for (auto it2=gds1.begin(); it2!=gds1.end(); it2++) {
+      // cout << "===========================\n";
+      // cout << "Gd_id: " << it2->first << "\n";
+      if (findwire || findgate) {
+         findwire = false;
+         findgate = false;
+         break;
+      }
 
-         // // calculate all Gds   
+      // the MAs of Gd = 1 alone, kept for all its candidates
+      MA_gd.clear();
+      vv.assign(1, gates[it2->first]->getVar());
+      vb.assign(1, true);
+      MA_gd.set(vv[0], vb[0]);
+      result_gd = rarImply(solver, imp, vv, vb, vector<int>(), MA_gd, win);
+      if (w.budgetOut()) return RAR_BUDGET;
+      // for (auto it3=GateMap.begin();it3!=GateMap.end();++it3){
+      //    cout << "id: " << it3->first << " value: " << MA_gd[it3->first] << "\n";
+      // }
+
+      // the queries of the candidates: Gd and the excitation (the same as for
+      // Wt), then the candidate last, so that the solver keeps the rest
+      vv.insert(vv.end(), excV.begin(), excV.end());
+      vb.insert(vb.end(), excB.begin(), excB.end());
+      size_t nPrefix = vv.size();
+
+      // for each wire in MA_wt but not in MA_gd
+
+      for (auto it3=wtGates.begin();it3!=wtGates.end(); ++it3){
+         if (MA_gd[*it3] == 2) {
+            if (_rarOpt.maxCands && nCands++ == _rarOpt.maxCands) return RAR_CANDS;
+            if (rarTimedOut()) return RAR_TIMEOUT;
+            MA_q.clear();
+            for (size_t k=1; k<nPrefix; ++k) MA_q.set(vv[k], vb[k]);
+            // for decision
+            vv.resize(nPrefix);
+            vb.resize(nPrefix);
+            vv.push_back(gates[*it3]->getVar());
+            vb.push_back(MA_wt[*it3]);
+
+
+            // cout << "select ID " << it3->first << " value " << vb[0] << "\n";
+
+            // the random patterns may show that the query gives no alternative
+            bool skip = _rarOpt.simFilter && rarSimRefutes(w.sim, vv, vb, id, *it3, wtGates, MA_wt, w.simHint);
+            ++w.nQuery;
+            if (skip) ++w.nSimSkip;
+            else result_gd = rarImply(solver, imp, vv, vb, fanout, MA_q, win);
+            if (w.budgetOut()) return RAR_BUDGET;
+            // for (auto it4=GateMap.begin();it4!=GateMap.end();++it4){
+            //    cout << "id: " << it4->first << " value: " << MA_gd[it4->first] << "\n";
+            // }
+            if (skip) {}
+            else if (!result_gd) {
+               if ( (*it3 != id) || ((GateMap.at(it2->first)->getFanin0()->getID() != *it3) 
+                                       && (GateMap.at(it2->first)->getFanin1()->getID() != *it3))){
+                  alts.push_back(RarAlt(*it3, MA_wt[*it3], -1, false, it2->first));
+                  findwire = true;
+               }
+            }
+            else if (*it3 != id) {
+               int it4 = rarDiffGate(w, MA_q, id, -1, -1);
+               if (it4 >= 0) {
+                  alts.push_back(RarAlt(*it3, MA_wt[*it3], it4, MA_wt[it4], it2->first));
+                  findgate = true;
+               }
+            }
+      //       // cout << (result_gd? "SAT" : "UNSAT") << endl;
 
-         // if (id == 344 || id == 345) {
-         //    for (size_t k=0; k<it->getFanout().size(); k++) {
-         //       cout << "fsdfdsf " << it->getFanout()[k]->getID() << "\n";
-         //    }
-         // }
-         
-         if (it->getFanout()[0]->getTypeStr() == "Aig") { // construct gds for first fanout
-            if(it->getFanout()[0]->getFanin0()->getID() == id) {
-               gds1.push_back(pair<int, int>(it->getFanout()[0]->getID(), 0));
-            } else {
-               gds1.push_back(pair<int, int>(it->getFanout()[0]->getID(), 1));  
+            if (findwire || findgate) {
+               break;
             }
          }
+      }
+   }
+   if (alts.empty() && _rarOpt.multi) {
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      int stop = rarMulti(w, id, gds1, fanout, excV, excB, nCands, alts);
+      w.multiTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      w.nMulti += alts.size();
+      return stop;
+   }
+   return RAR_DONE;
+}
 
-         findAllgd(it->getFanout()[0]->getID(), gds1, check_gd);
-         clear_MA(check_gd);
-         if (it->getFanout().size() > 1) { // check other fanouts and compare with gds1, then get final gds1
-            for (size_t i=1; i<it->getFanout().size(); ++i) {
-               if(it->getFanout()[i]->getTypeStr() == "Aig") {
-                  if(it->getFanout()[i]->getFanin0()->getID() == id) {
-                     gds2.push_back(pair<int, int>(it->getFanout()[i]->getID(), 0));
-                  } else {
-                     gds2.push_back(pair<int, int>(it->getFanout()[i]->getID(), 1));  
-                  }
-               }
-               findAllgd(it->getFanout()[i]->getID(), gds2, check_gd);
-               clear_MA(check_gd);
+// CIRSatRAR -Multi: the alternative gates of 2 and 3 inputs of target "id",
+// when rarTarget() found no alternative. For each Gd and pair of candidates
+// (a, b) of wtGates not implied by Gd alone, the query Gd = 1, a = MA_wt[a],
+// b = MA_wt[b] with the excitation either conflicts (gate a & b -> Gd) or may
+// imply some c to the other value than MA_wt (gate a & b & c -> Gd). The
+// excitation is only that of the Gds after Gd, which is what the test of the
+// new input of Gd needs (with all of it, few 3-input gates pass rarCommit()).
+// "b" comes last, so that the solver keeps the rest of the query.
+// Return the RarStop
+int CirMgr::rarMulti(RarWorker& w, int id, const vector<pair<int,int>>& gds, const vector<int>& fanout,
+                     const vector<Var>& excV, const vector<bool>& excB, unsigned& nCands,
+                     vector<RarAlt>& alts) {
+   const vector<int>& wtGates = w.wtGates;
+   const RarMA& MA_wt = w.MA_wt;
+   RarMA& MA_gd = w.MA_gd;
+   RarMA& MA_q = w.MA_q;
+   const RarWindow* win = _rarOpt.window || _rarOpt.lazyCnf? &w.win: 0;
+   vector<Var> vv;
+   vector<bool> vb;
+   size_t e0 = 0;   // excitation of gds[0..i]
+   for (size_t i=0; i<gds.size(); ++i) {
+      int gd = gds[i].first;
+      if (gds[i].second != 2) ++e0;
+      // the candidates: free after Gd = 1 alone
+      MA_gd.clear();
+      vv.assign(1, w.gates[gd]->getVar()); vb.assign(1, true);
+      rarImply(*w.solver, w.imp, vv, vb, vector<int>(), MA_gd, win);
+      if (w.budgetOut()) return RAR_BUDGET;
+      vector<int> cands;
+      for (size_t j=0; j<wtGates.size(); ++j) {
+         if (wtGates[j] != id && MA_gd[wtGates[j]] == 2) cands.push_back(wtGates[j]);
+      }
+      for (size_t j=0; j<cands.size(); ++j) {
+         int a = cands[j];
+         // the prefix of the queries of the pairs
+         MA_gd.clear();
+         vv.assign(1, w.gates[gd]->getVar()); vb.assign(1, true);
+         vv.push_back(w.gates[a]->getVar()); vb.push_back(MA_wt[a]);
+         vv.insert(vv.end(), excV.begin() + e0, excV.end());
+         vb.insert(vb.end(), excB.begin() + e0, excB.end());
+         bool result = rarImply(*w.solver, w.imp, vv, vb, fanout, MA_gd, win);
+         if (w.budgetOut()) return RAR_BUDGET;
+         if (!result) continue;
+         for (size_t k=j+1; k<cands.size(); ++k) {
+            int b = cands[k];
+            if (MA_gd[b] != 2) continue;   // (implied by Gd and a)
+            if (_rarOpt.maxCands && nCands++ == _rarOpt.maxCands) return RAR_CANDS;
+            if (rarTimedOut()) return RAR_TIMEOUT;
+            vv.resize(excV.size() - e0 + 2); vb.resize(excV.size() - e0 + 2);
+            vv.push_back(w.gates[b]->getVar()); vb.push_back(MA_wt[b]);
+            ++w.nQuery;
+            if (_rarOpt.simFilter && rarSimRefutes(w.sim, vv, vb, id, a, wtGates, MA_wt, w.simHint)) {
+               ++w.nSimSkip;
+               continue;
+            }
+            MA_q.clear();
+            result = rarImply(*w.solver, w.imp, vv, vb, fanout, MA_q, win);
+            if (w.budgetOut()) return RAR_BUDGET;
+            if (!result) {
+               alts.push_back(RarAlt(a, MA_wt[a], b, MA_wt[b], gd));
+               return RAR_DONE;
             }
-            compareTwogds(gds1, gds2);
-            gds2.clear();
-            if(gds1.size() == 0) {
-               gds1.clear();  
+            int c = rarDiffGate(w, MA_q, id, a, b);
+            if (c >= 0) {
+               alts.push_back(RarAlt(a, MA_wt[a], b, MA_wt[b], gd, c, MA_wt[c]));
+               return RAR_DONE;
             }
          }
+      }
+   }
+   return RAR_DONE;
+}
 
-         // for (size_t k=0; k<gds1.size(); k++) {
-         //    cout << "  gds  " << gds1[k].first << "\n";
-         // }
-
+// Extract the _rarOpt.window-level window of target "id" into "win" (replacing
+// the previous one) and return a new solver with its CNF; gates on the border
+// of the window are free, so the window only loses implications: its targets
+// are a subset of those of the full CNF, though the first alternative found
+// for a target may be another one
+SatSolver* CirMgr::rarWindow(RarWindow& win, int id) const {
+   for (size_t i=1; i<win.ids.size(); ++i) {
+      win.var[win.ids[i]] = -1;
+      win.tfo[win.ids[i]] = 0;
+   }
+   win.ids.resize(1);
+
+   // the fanouts of the target, level by level
+   vector<int> cur(1, id), next;
+   win.var[id] = win.ids.size(); win.ids.push_back(id);
+   win.tfo[id] = 1;
+   for (unsigned l=0; l<_rarOpt.window && !cur.empty(); ++l) {
+      for (size_t i=0; i<cur.size(); ++i) {
+         vector<CirGate*> fanout = GateMap.at(cur[i])->getFanout();
+         for (size_t j=0; j<fanout.size(); ++j) {
+            int fo = fanout[j]->getID();
+            if (fanout[j]->getTypeStr() != "Aig" || win.tfo[fo]) continue;
+            win.tfo[fo] = 1;
+            if (win.var[fo] < 0) { win.var[fo] = win.ids.size(); win.ids.push_back(fo); }
+            next.push_back(fo);
+         }
+      }
+      cur.swap(next); next.clear();
+   }
 
-         for (size_t i=0; i<gds1.size(); ++i) {
-            fanout.push_back(gds1[i].first);
+   // and their fanins
+   cur.assign(win.ids.begin() + 1, win.ids.end());
+   for (unsigned l=0; l<_rarOpt.window && !cur.empty(); ++l) {
+      for (size_t i=0; i<cur.size(); ++i) {
+         CirGate* g = GateMap.at(cur[i]);
+         if (g->getTypeStr() != "Aig") continue;
+         CirGate* fanin[2] = { g->getFanin0(), g->getFanin1() };
+         for (int j=0; j<2; ++j) {
+            int fi = fanin[j]->getID();
+            if (win.var[fi] >= 0) continue;
+            win.var[fi] = win.ids.size(); win.ids.push_back(fi);
+            next.push_back(fi);
          }
-         
+      }
+      cur.swap(next); next.clear();
+   }
 
-         // excitation
-         vector<int> empty;
+   SatSolver* s = new SatSolver;
+   s->initialize();
+   for (size_t i=1; i<win.ids.size(); ++i) s->newVar();
+   for (size_t i=1; i<win.ids.size(); ++i) {
+      CirGate* g = GateMap.at(win.ids[i]);
+      if (g->getTypeStr() != "Aig") continue;
+      int v0 = win.var[g->getFanin0()->getID()], v1 = win.var[g->getFanin1()->getID()];
+      if (v0 >= 0 && v1 >= 0) s->addAigCNF(i, v0, g->getInv0(), v1, g->getInv1());
+   }
+   return s;
+}
 
-         for (auto it2=gds1.begin(); it2!=gds1.end(); it2++) {
-            if (it2->second == 1) {
-               vv.push_back(gates[GateMap[it2->first]->getFanin0()->getID()]->getVar());
-               if (GateMap[it2->first]->getInv0()) vb.push_back(false);
-               else vb.push_back(true);
+// -Lazy: add to "s" the CNF of the AIG gates in the cone of target "id" (its
+// transitive fanouts and their transitive fanins) that it does not have yet,
+// with a new Var for each gate they bring in. The gates of "win" are closed
+// under fanins, and the TFO walk stops at a gate whose cone is already in
+void CirMgr::rarLazy(RarWindow& win, SatSolver& s, int id) const {
+   if (win.tfo[id]) return;
+   vector<int> tfo(1, id), stack;
+   win.tfo[id] = 1;
+   for (size_t i=0; i<tfo.size(); ++i) {
+      vector<CirGate*> fanout = GateMap.at(tfo[i])->getFanout();
+      for (size_t j=0; j<fanout.size(); ++j) {
+         int fo = fanout[j]->getID();
+         if (fanout[j]->getTypeStr() != "Aig" || win.tfo[fo]) continue;
+         win.tfo[fo] = 1;
+         tfo.push_back(fo);
+      }
+   }
+   for (size_t i=0; i<tfo.size(); ++i) {
+      if (win.var[tfo[i]] >= 0) continue;
+      win.var[tfo[i]] = s.newVar(); win.ids.push_back(tfo[i]);
+      stack.push_back(tfo[i]);
+   }
+   while (!stack.empty()) {
+      CirGate* g = GateMap.at(stack.back());
+      stack.pop_back();
+      if (g->getTypeStr() != "Aig") continue;
+      CirGate* fanin[2] = { g->getFanin0(), g->getFanin1() };
+      for (int j=0; j<2; ++j) {
+         int fi = fanin[j]->getID();
+         if (win.var[fi] >= 0) continue;
+         win.var[fi] = s.newVar(); win.ids.push_back(fi);
+         stack.push_back(fi);
+      }
+      s.addAigCNF(win.var[g->getID()], win.var[fanin[0]->getID()], g->getInv0(),
+                  win.var[fanin[1]->getID()], g->getInv1());
+   }
+}
 
-            } else {
-               vv.push_back(gates[GateMap[it2->first]->getFanin1()->getID()]->getVar());
-               if (GateMap[it2->first]->getInv1()) vb.push_back(false);
-               else vb.push_back(true);
-            }
+// replace the fanins "from" of "h" by "to" (inverted if "inv")
+static void rarReplaceFanin(CirGate* h, CirGate* from, CirGate* to, bool inv) {
+   if (h->getFanin0() == from) { h->setFanin0(to, h->getInv0() ^ inv); to->pushFanout(h); }
+   if (h->getFanin1() == from) { h->setFanin1(to, h->getInv1() ^ inv); to->pushFanout(h); }
+}
 
-            MA_wt[vv[vv.size()-1]] = vb[vb.size()-1];
-         }
+// let every fanout of "g" read "to" (inverted if "inv") instead
+static void rarMoveFanouts(CirGate* g, CirGate* to, bool inv) {
+   vector<CirGate*> fanout = g->getFanout();
+   for (size_t i=0; i<fanout.size(); ++i) {
+      rarReplaceFanin(fanout[i], g, to, inv);
+      g->removeFanout(fanout[i]);
+   }
+}
 
-         // for (size_t j=0; j<vv.size(); j++) {
-         //    cout << vv[j] << "  " << vb[j] << "\n";
-         // }
+// the number of AIG gates that only "g" uses (its MFFC, "g" included),
+// without counting "a", "b" and their fanins
+static int rarMffc(CirGate* g, CirGate* a, CirGate* b, CirGate* c = 0) {
+   map<CirGate*, int> ref;
+   vector<CirGate*> stack(1, g);
+   int n = 0;
+   while (!stack.empty()) {
+      CirGate* h = stack.back();
+      stack.pop_back();
+      ++n;
+      CirGate* fanin[2] = { h->getFanin0(), h->getFanin1() };
+      for (int i=0; i<2; ++i) {
+         CirGate* f = fanin[i];
+         if (f->getTypeStr() != "Aig" || f == a || f == b || f == c) continue;
+         if (!ref.count(f)) ref[f] = f->getFanout().size();
+         if (--ref[f] == 0) stack.push_back(f);
+      }
+   }
+   return n;
+}
 
-         solver.assumeVec(vv, vb);
-         // cout << gds1.size() << "   " <<  vv.size() << "   " << vb.size() << "\n";
+// sort "targets" by _rarOpt.order, the larger keys first and equal keys in the
+// order of IDs
+void CirMgr::rarOrder(vector<int>& targets) const {
+   if (_rarOpt.order == RAR_ORDER_ID) return;
+   vector<double> key(GateMap.rbegin()->first + 1, 0);
+   if (_rarOpt.order == RAR_ORDER_LEVEL || _rarOpt.order == RAR_ORDER_CONE) {
+      // (the cone size counts a fanin once per path to it, so it may overflow to inf)
+      vector<CirGate*> order;
+      rarTopoOrder(GateMap, order);
+      for (size_t i=0; i<order.size(); ++i) {
+         CirGate* g = order[i];
+         if (g->getTypeStr() != "Aig") continue;
+         double k0 = key[g->getFanin0()->getID()], k1 = key[g->getFanin1()->getID()];
+         if (_rarOpt.order == RAR_ORDER_LEVEL) key[g->getID()] = 1 + (k0 > k1? k0: k1);
+         else key[g->getID()] = 1 + k0 + k1;
+      }
+   }
+   for (size_t i=0; i<targets.size(); ++i) {
+      CirGate* g = GateMap.at(targets[i]);
+      if (_rarOpt.order == RAR_ORDER_FANOUT) key[targets[i]] = g->getFanout().size();
+      else if (_rarOpt.order == RAR_ORDER_GAIN) key[targets[i]] = rarMffc(g, 0, 0);
+   }
 
-         result_wt = solver.assumpRARSolve(MA_wt, fanout);
-         // solver.printStats();
-         // for (auto it2=GateMap.begin();it2!=GateMap.end();++it2){
-         //    cout << "id: " << it2->first << " value: " << MA_wt[it2->first] << "\n";
-         // }
+   vector<pair<double, int>> sorted(targets.size());
+   for (size_t i=0; i<targets.size(); ++i) sorted[i] = make_pair(-key[targets[i]], targets[i]);
+   sort(sorted.begin(), sorted.end());
+   for (size_t i=0; i<targets.size(); ++i) targets[i] = sorted[i].second;
+}
 
-         solver.assumeRelease();
-         solver.resetAssign();
+// CNF variable of gate "g" in the netlist changed by rarCommit(): the gates
+// marked in "region" get new variables (cached in "shadow"), the others keep
+// vars[g]
+Lit CirMgr::rarShadow(SatSolver& s, const vector<Var>& vars, vector<Lit>& shadow,
+                      const vector<bool>& region, CirGate* g) const {
+   int id = g->getID();
+   if (!region[id]) return Lit(vars[id]);
+   if (shadow[id] != lit_Undef) return shadow[id];
+   Lit l0 = rarShadow(s, vars, shadow, region, g->getFanin0());
+   Lit l1 = rarShadow(s, vars, shadow, region, g->getFanin1());
+   if (g->getInv0()) l0 = ~l0;
+   if (g->getInv1()) l1 = ~l1;
+   Var v = s.newVar();
+   s.addAigCNF(v, var(l0), sign(l0), var(l1), sign(l1));
+   return shadow[id] = Lit(v);
+}
 
-         // cout << (result_wt? "SAT" : "UNSAT") << endl;
+// Propagate CONST0 and trivial ANDs (a & a, a & !a) from the gates in "work";
+// then delete the AIG gates in "dead" and the AIG gates left without fanouts.
+// Return the number of AIG gates deleted
+int CirMgr::rarSweep(vector<CirGate*>& work, vector<CirGate*>& dead) {
+   while (!work.empty()) {
+      CirGate* g = work.back();
+      work.pop_back();
+      _rarEdited.push_back(g->getID());
+      if (g->getTypeStr() != "Aig" || g->getFanout().empty()) continue;
+      CirGate *p0 = g->getFanin0(), *p1 = g->getFanin1(), *r = 0;
+      bool i0 = g->getInv0(), i1 = g->getInv1(), inv = false;
+      if (p0 == const0) { r = i0? p1: const0; inv = i0 && i1; }
+      else if (p1 == const0) { r = i1? p0: const0; inv = i1 && i0; }
+      else if (p0 == p1) { r = i0 == i1? p0: const0; inv = i0 == i1 && i0; }
+      if (!r) continue;
+      vector<CirGate*> fanout = g->getFanout();
+      rarMoveFanouts(g, r, inv);
+      _rarEdited.push_back(r->getID());
+      work.insert(work.end(), fanout.begin(), fanout.end());
+      dead.push_back(g);
+   }
 
-         vv.clear();
-         vb.clear();
-         solver.assumeRelease();
-         solver.resetAssign();
+   set<CirGate*> deleted;
+   int n = 0;
+   while (!dead.empty()) {
+      CirGate* g = dead.back();
+      dead.pop_back();
+      if (deleted.count(g) || g->getTypeStr() != "Aig" || !g->getFanout().empty()) continue;
+      g->getFanin0()->removeFanout(g);
+      g->getFanin1()->removeFanout(g);
+      _rarEdited.push_back(g->getFanin0()->getID());
+      _rarEdited.push_back(g->getFanin1()->getID());
+      dead.push_back(g->getFanin0());
+      dead.push_back(g->getFanin1());
+      GateMap.erase(g->getID());
+      _aiglist.erase(find(_aiglist.begin(), _aiglist.end(), g));
+      deleted.insert(g);
+      delete g;
+      ++n;
+   }
+   return n;
+}
 
-         // for each Gd
-         for (auto it2=gds1.begin(); it2!=gds1.end(); it2++) {
-            // cout << "===========================\n";
-            // cout << "Gd_id: " << it2->first << "\n";
-            if (findwire || findgate) {
-               findwire = false;
-               findgate = false;
-               break;
-            }
+// Apply "alt" to target "t" if that removes AIG gates: add the alternative
+// wire/gate to Gd (as a new AND gate gd & alt on the fanouts of Gd), replace
+// "t" by CONST0 and sweep. The change is first checked to keep every PO, with
+// the CNF of the changed gates added to "s" (the CNF of the netlist, gate g on
+// vars[g]); return false if it is not applied
+bool CirMgr::rarCommit(SatSolver& s, vector<Var>& vars, int t, const RarAlt& alt) {
+   // the gates may have been changed by the previous commits
+   if (!GateMap.count(t) || !GateMap.count(alt.gd) || !GateMap.count(alt.src)) return false;
+   if (alt.src2 >= 0 && !GateMap.count(alt.src2)) return false;
+   if (alt.src3 >= 0 && !GateMap.count(alt.src3)) return false;
+   CirGate *tg = GateMap[t], *gd = GateMap[alt.gd], *a = GateMap[alt.src];
+   CirGate *b = alt.src2 >= 0? GateMap[alt.src2]: 0, *c = alt.src3 >= 0? GateMap[alt.src3]: 0;
+   if (tg->getTypeStr() != "Aig" || tg->getFanout().empty() || gd->getTypeStr() != "Aig") return false;
+   if (a->getTypeStr() == "Po" || (b && b->getTypeStr() == "Po") || (c && c->getTypeStr() == "Po"))
+      return false;
+
+   // the changed gates: the TFO of Gd and of the target; the new
+   // wire/gate must not come from the TFO of Gd. The new gates are n (Gd and
+   // the new input), m (a & b) and k (m & c)
+   int nId = GateMap.rbegin()->first + 1, mId = nId + 1, kId = mId + 1;
+   vector<bool> region(kId + 1, false);
+   vector<CirGate*> stack(1, gd);
+   region[alt.gd] = true;
+   for (int k=0; k<2; ++k) {
+      while (!stack.empty()) {
+         vector<CirGate*> fanout = stack.back()->getFanout();
+         stack.pop_back();
+         for (size_t i=0; i<fanout.size(); ++i) {
+            if (region[fanout[i]->getID()]) continue;
+            region[fanout[i]->getID()] = true;
+            stack.push_back(fanout[i]);
+         }
+      }
+      if (k == 0 && (region[alt.src] || (b && region[alt.src2]) || (c && region[alt.src3]))) return false;
+      if (k == 0) { stack.push_back(tg); region[t] = true; }
+   }
 
-            solver.assumeRelease();
+   // at least the MFFC of the target and its AIG fanouts go away
+   int added = c? 3: b? 2: 1, gain = rarMffc(tg, a, b, c) - added;
+   vector<CirGate*> tFanout = tg->getFanout();
+   sort(tFanout.begin(), tFanout.end());
+   tFanout.erase(unique(tFanout.begin(), tFanout.end()), tFanout.end());
+   for (size_t i=0; i<tFanout.size(); ++i) {
+      if (tFanout[i]->getTypeStr() == "Aig") ++gain;
+   }
+   if (gain <= 0) return false;
+
+   // encode the changed netlist
+   vars.resize(kId + 1, 0);
+   vector<Lit> shadow(kId + 1, lit_Undef);
+   shadow[t] = Lit(vars[0]);   // CONST0
+   Lit gdLit = rarShadow(s, vars, shadow, region, gd);
+   Lit la = rarShadow(s, vars, shadow, region, a), lm, lk, lin;
+   if (b) {
+      Lit lb = rarShadow(s, vars, shadow, region, b);
+      lm = Lit(s.newVar());
+      s.addAigCNF(var(lm), var(la), sign(la) ^ !alt.val, var(lb), sign(lb) ^ !alt.val2);
+   }
+   if (c) {
+      Lit lc = rarShadow(s, vars, shadow, region, c);
+      lk = Lit(s.newVar());
+      s.addAigCNF(var(lk), var(lm), false, var(lc), sign(lc) ^ !alt.val3);
+   }
+   // the new input of Gd, as set on n below
+   if (c) lin = ~lk;
+   else if (b) lin = ~lm;
+   else lin = alt.val? ~la: la;
+   Lit ln = Lit(s.newVar());
+   s.addAigCNF(var(ln), var(gdLit), sign(gdLit), var(lin), sign(lin));
+   shadow[alt.gd] = ln;
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      if (region[it->first] && it->second->getTypeStr() == "Aig") rarShadow(s, vars, shadow, region, it->second);
+   }
 
-            vv.push_back(gates[it2->first]->getVar());
-            vb.push_back(true);
-            
-            MA_gd[vv[0]] = vb[0];
-            solver.assumeVec(vv, vb);
-            result_gd = solver.assumpRARSolve(MA_gd, empty);
-            // for (auto it3=GateMap.begin();it3!=GateMap.end();++it3){
-            //    cout << "id: " << it3->first << " value: " << MA_gd[it3->first] << "\n";
-            // }
-            solver.assumeRelease();
-            solver.resetAssign();
-
-            // for each wire in MA_wt but not in MA_gd
-
-            for (auto it3=GateMap.begin();it3!=GateMap.end(); ++it3){
-               if ((MA_wt[it3->first] != 2) && (MA_gd[it3->first] == 2)) {
-                  // for Gd
-                  vv.push_back(gates[it2->first]->getVar());
-                  vb.push_back(true);
-                  // for decision
-                  vv.push_back(gates[it3->first]->getVar());
-                  vb.push_back(MA_wt[it3->first]);
-
-                  if (it->getFanout()[0]->getTypeStr() == "Aig") { // construct gds for first fanout
-                     if(it->getFanout()[0]->getFanin0()->getID() == it3->first) {
-                        gds3.push_back(pair<int, int>(it->getFanout()[0]->getID(), 0));
-                     } else {
-                        gds3.push_back(pair<int, int>(it->getFanout()[0]->getID(), 1));  
-                     }
-                  }
+   // miter of the changed POs, enabled by "act"
+   Var act = s.newVar();
+   vector<Var> vv(1, act);
+   vector<bool> vb(1, true);
+   for (size_t i=0; i<_polist.size(); ++i) {
+      CirGate* f = _polist[i]->getFanin0();
+      if (!region[f->getID()]) continue;
+      Lit lo = Lit(vars[f->getID()]), lf = rarShadow(s, vars, shadow, region, f);
+      Var x = s.newVar();
+      s.addXorCNF(x, var(lo), sign(lo), var(lf), sign(lf));
+      vv.push_back(x);
+      vb.push_back(false);
+   }
+   s.addCNF(vv, vb);
+   s.assumeRelease();
+   s.assumeProperty(act, true);
+   bool differ = s.assumpSolve();
+   s.assumeRelease();
+   s.assertProperty(act, false);
+   if (differ) return false;
+
+   // commit
+   CirGate *m = 0, *kg = 0;
+   if (b) {
+      m = new CirAigGate(0, 0, mId, 0, 0, 0);
+      m->setFanin0(a, !alt.val);
+      m->setFanin1(b, !alt.val2);
+      a->pushFanout(m);
+      b->pushFanout(m);
+      GateMap[mId] = m;
+      _aiglist.push_back(m);
+   }
+   if (c) {
+      kg = new CirAigGate(0, 0, kId, 0, 0, 0);
+      kg->setFanin0(m, false);
+      kg->setFanin1(c, !alt.val3);
+      m->pushFanout(kg);
+      c->pushFanout(kg);
+      GateMap[kId] = kg;
+      _aiglist.push_back(kg);
+   }
+   CirGate* ng = new CirAigGate(0, 0, nId, 0, 0, 0);
+   rarMoveFanouts(gd, ng, false);
+   ng->setFanin0(gd, false);
+   gd->pushFanout(ng);
+   if (c) { ng->setFanin1(kg, true); kg->pushFanout(ng); }
+   else if (b) { ng->setFanin1(m, true); m->pushFanout(ng); }
+   else { ng->setFanin1(a, alt.val); a->pushFanout(ng); }
+   GateMap[nId] = ng;
+   _aiglist.push_back(ng);
+   if (M < (c? kId: b? mId: nId)) M = c? kId: b? mId: nId;
+
+   for (int i=0; i<=kId; ++i) {
+      if (shadow[i] != lit_Undef) vars[i] = var(shadow[i]);
+   }
+   vars[alt.gd] = var(gdLit);
+   vars[nId] = var(ln);
+   if (b) vars[mId] = var(lm);
+   if (c) vars[kId] = var(lk);
+
+   // (the fanouts of Gd, now on n, are in the TFO of n)
+   int edited[] = { alt.gd, alt.src, alt.src2, alt.src3, nId };
+   for (int i=0; i<5; ++i) if (edited[i] >= 0) _rarEdited.push_back(edited[i]);
+   vector<CirGate*> work = tg->getFanout(), dead(1, tg);
+   rarMoveFanouts(tg, const0, false);
+   int n = rarSweep(work, dead) - added;
+
+   if (_rarOpt.out) return true;
+   cout << "Apply: ";
+   if (c) cout << "multi-gate " << alt.src << " & " << alt.src2 << " & " << alt.src3 << " -> " << alt.gd;
+   else if (b) cout << "gate " << alt.src << " & " << alt.src2 << " -> " << alt.gd;
+   else cout << "wire " << alt.src << " -> " << alt.gd;
+   cout << ", removing " << t << " (-" << n << " AIGs)\n";
+   return true;
+}
 
-                  findAllgd(it->getFanout()[0]->getID(), gds3, check_gd);
-                  clear_MA(check_gd);
-                  if (it->getFanout().size() > 1) { // check other fanouts and compare with gds1, then get final gds1
-                     for (size_t i=1; i<it->getFanout().size(); ++i) {
-                        if(it->getFanout()[i]->getTypeStr() == "Aig") {
-                           if(it->getFanout()[i]->getFanin0()->getID() == it3->first) {
-                              gds4.push_back(pair<int, int>(it->getFanout()[i]->getID(), 0));
-                           } else {
-                              gds4.push_back(pair<int, int>(it->getFanout()[i]->getID(), 1));  
-                           }
-                        }
-                        findAllgd(it->getFanout()[i]->getID(), gds4, check_gd);
-                        clear_MA(check_gd);
-                     }
-                     compareTwogds(gds3, gds4);
-                     gds4.clear();
-                     if(gds3.size() == 0) {
-                        gds3.clear();  
-                     }
-                  }
+/*************************************/
+/*   class RarCheckpoint functions   */
+/*************************************/
+// file layout: magic, options, round, applied, aig, netlist, original,
+// rejected, results, done (non-empty ones, with their target ID), magic again
+static const char RAR_CKPT_MAGIC[8] = { 'R', 'A', 'R', 'C', 'K', 'P', 'T', '2' };
+
+template<class T> static void rarPut(ostream& os, T x) { os.write((const char*)&x, sizeof(T)); }
+template<class T> static bool rarGet(istream& is, T& x) { return bool(is.read((char*)&x, sizeof(T))); }
+
+static void rarPutRecords(ostream& os, const vector<RarRecord>& recs) {
+   rarPut<uint64_t>(os, recs.size());
+   for (size_t i=0; i<recs.size(); ++i) {
+      const RarRecord& r = recs[i];
+      rarPut<uint32_t>(os, r.round);
+      rarPut<int32_t>(os, r.target);
+      rarPut<int32_t>(os, r.gd);
+      for (int k=0; k<3; ++k) rarPut<int32_t>(os, r.src[k]);
+      rarPut<uint8_t>(os, r.val[0] | r.val[1] << 1 | r.val[2] << 2 | r.applied << 3 | r.cached << 4);
+      rarPut<uint8_t>(os, r.stop);
+      rarPut<uint32_t>(os, r.queries);
+      rarPut<double>(os, r.seconds);
+   }
+}
 
-                  for (auto it4=gds3.begin(); it4!=gds3.end(); it4++) {
-                     if (it4->second == 1) {
-                        vv.push_back(gates[GateMap[it4->first]->getFanin0()->getID()]->getVar());
-                        if (GateMap[it4->first]->getInv0()) vb.push_back(false);
-                        else vb.push_back(true);
+static bool rarGetRecords(istream& is, vector<RarRecord>& recs) {
+   uint64_t n;
+   if (!rarGet(is, n)) return false;
+   recs.assign(n, RarRecord());
+   for (size_t i=0; i<n; ++i) {
+      RarRecord& r = recs[i];
+      uint32_t round, queries;
+      int32_t target, gd, src[3];
+      uint8_t flags, stop;
+      if (!rarGet(is, round) || !rarGet(is, target) || !rarGet(is, gd) || !rarGet(is, src[0])
+          || !rarGet(is, src[1]) || !rarGet(is, src[2]) || !rarGet(is, flags) || !rarGet(is, stop)
+          || !rarGet(is, queries) || !rarGet(is, r.seconds) || stop >= RAR_TOT_STOP)
+         return false;
+      r.round = round; r.target = target; r.gd = gd; r.queries = queries; r.stop = stop;
+      for (int k=0; k<3; ++k) { r.src[k] = src[k]; r.val[k] = flags >> k & 1; }
+      r.applied = flags >> 3 & 1;
+      r.cached = flags >> 4 & 1;
+   }
+   return true;
+}
 
-                     } else {
-                        vv.push_back(gates[GateMap[it4->first]->getFanin1()->getID()]->getVar());
-                        if (GateMap[it4->first]->getInv1()) vb.push_back(false);
-                        else vb.push_back(true);
-                     }
+// false unless "aag" reads as a netlist that writes back as "aag" (the
+// netlists of a checkpoint come from CirMgr::writeAag())
+static bool rarAagOk(const string& aag) {
+   if (aag.compare(0, 4, "aag ")) return false;
+   CirMgr mgr;
+   istringstream is(aag);
+   stringstream os;
+   mgr.readCircuit(is);
+   mgr.writeAag(os);
+   return os.str() == aag;
+}
 
-                     MA_gd[vv[vv.size()-1]] = vb[vb.size()-1];
-                  }
+bool RarCheckpoint::write(const string& file) const {
+   string tmp = file + ".tmp";
+   ofstream os(tmp.c_str(), ios::out | ios::binary);
+   if (!os) return false;
+   os.write(RAR_CKPT_MAGIC, sizeof(RAR_CKPT_MAGIC));
+   uint32_t o[] = { opt.aigImp, opt.lazyCnf, opt.apply, opt.multi, opt.window, opt.order, opt.top,
+                    opt.maxTargets, opt.maxCands, opt.maxProps };
+   for (size_t i=0; i<sizeof(o)/sizeof(o[0]); ++i) rarPut(os, o[i]);
+   rarPut<uint32_t>(os, round);
+   rarPut<uint32_t>(os, applied);
+   rarPut<uint32_t>(os, aig);
+   rarPut<uint64_t>(os, netlist.size());
+   os.write(netlist.data(), netlist.size());
+   rarPut<uint64_t>(os, original.size());
+   os.write(original.data(), original.size());
+   rarPut<uint64_t>(os, rejected.size());
+   for (size_t i=0; i<rejected.size(); ++i) rarPut<uint8_t>(os, rejected[i]);
+   rarPutRecords(os, results);
+   uint64_t n = 0;
+   for (size_t t=0; t<done.size(); ++t) n += !done[t].empty();
+   rarPut(os, n);
+   for (size_t t=0; t<done.size(); ++t) {
+      if (done[t].empty()) continue;
+      rarPut<uint32_t>(os, t);
+      rarPutRecords(os, done[t]);
+   }
+   os.write(RAR_CKPT_MAGIC, sizeof(RAR_CKPT_MAGIC));
+   os.close();
+   return os && rename(tmp.c_str(), file.c_str()) == 0;
+}
 
-                   for (size_t m=0; m<gds3.size(); ++m) {
-                     fanout.push_back(gds1[m].first);
-                  }
+// false if "file" cannot be read or is not a whole checkpoint
+bool RarCheckpoint::read(const string& file) {
+   ifstream is(file.c_str(), ios::in | ios::binary);
+   char magic[sizeof(RAR_CKPT_MAGIC)];
+   if (!is.read(magic, sizeof(magic)) || memcmp(magic, RAR_CKPT_MAGIC, sizeof(magic))) return false;
+   uint32_t o[10];
+   for (int i=0; i<10; ++i) if (!rarGet(is, o[i])) return false;
+   opt.aigImp = o[0]; opt.lazyCnf = o[1]; opt.apply = o[2]; opt.multi = o[3]; opt.window = o[4];
+   opt.order = RarOrder(o[5]); opt.top = o[6]; opt.maxTargets = o[7]; opt.maxCands = o[8];
+   opt.maxProps = o[9];
+   uint32_t r, a, g;
+   uint64_t n;
+   if (!rarGet(is, r) || !rarGet(is, a) || !rarGet(is, g) || !rarGet(is, n)) return false;
+   round = r; applied = a; aig = g;
+   netlist.resize(n);
+   if (!is.read(&netlist[0], n) || !rarAagOk(netlist) || !rarGet(is, n)) return false;
+   original.resize(n);
+   if (!is.read(&original[0], n) || (opt.apply && !rarAagOk(original)) || !rarGet(is, n)) return false;
+   rejected.resize(n);
+   for (size_t i=0; i<n; ++i) {
+      uint8_t b;
+      if (!rarGet(is, b)) return false;
+      rejected[i] = b;
+   }
+   if (!rarGetRecords(is, results) || !rarGet(is, n)) return false;
+   done.clear();
+   for (size_t i=0; i<n; ++i) {
+      uint32_t t;
+      if (!rarGet(is, t)) return false;
+      if (done.size() <= t) done.resize(t + 1);
+      if (!rarGetRecords(is, done[t]) || done[t].empty()) return false;
+   }
+   return is.read(magic, sizeof(magic)) && !memcmp(magic, RAR_CKPT_MAGIC, sizeof(magic));
+}
 
+bool RarCheckpoint::sameOptions(const RarOption& o) const {
+   return opt.aigImp == o.aigImp && opt.lazyCnf == o.lazyCnf && opt.apply == o.apply
+       && opt.multi == o.multi && opt.window == o.window && opt.order == o.order && opt.top == o.top
+       && opt.maxTargets == o.maxTargets && opt.maxCands == o.maxCands && opt.maxProps == o.maxProps;
+}
 
-                  
-                  solver.assumeVec(vv, vb);
-                  // cout << "select ID " << it3->first << " value " << vb[0] << "\n";
-
-                  result_gd = solver.assumpRARSolve(MA_gd, fanout);
-                  fanout.clear();
-                  // for (auto it4=GateMap.begin();it4!=GateMap.end();++it4){
-                  //    cout << "id: " << it4->first << " value: " << MA_gd[it4->first] << "\n";
-                  // }
-                  if (!result_gd) {
-                     if ( (it3->first != id) || ((GateMap[it2->first]->getFanin0()->getID() != it3->first) 
-                                             && (GateMap[it2->first]->getFanin1()->getID() != it3->first))){
-                        cout << "alternative wire: " << it3->first << " -> " << it2->first << "  " << count_alt << "\n"; 
-                        findwire = true;
-                        count_alt ++;
-                     }
-                  }
-                  else {
-                     for (auto it4=GateMap.begin();it4!=GateMap.end();++it4){
-                        if((MA_gd[it4->first] != 2) && (MA_wt[it4->first] != 2) && (MA_wt[it4->first] != MA_gd[it4->first]) && it3->first != id && it4->first != id) {
-                           cout << "alternative gate: " << it3->first  << " & " << it4->first << " -> " << it2->first << "\n"; 
-                           isConflict = true;
-                           count_alt ++;
-                           // cout << "count_alt: " << count_alt << "\n";
-                           findgate = true;
-                           break;
-                        }
-                        // if(!isConflict) {
-                        //    for (auto it5=GateMap.begin(); it5!=GateMap.end(); it5++) {
-                        //       vv.clear();
-                        //       vb.clear();S
-                        //       solver.assumeRelease();
-                        //       solver.resetAssign();
-                        //       if ((MA_gd[it5->first] != 2) && (MA_wt[it5->first] == 2)) {
-                        //          // for Gd
-                        //          vv.push_back(gates[it2->first]->getVar());
-                        //          vb.push_back(true);
-                        //          // for decision of Wt
-                        //          vv.push_back(gates[it3->first]->getVar());
-                        //          vb.push_back(MA_wt[it3->first]);
-                        //          // for decision of Gd
-                        //          vv.push_back(gates[it3->first]->getVar());
-                        //          vb.push_back(MA_wt[it3->first]);
-                        //          solver.assumeVec(vv, vb);
-                        //          result_wt2 = solver.assumpRARSolve(MA_wt2, empty);
-                        //       }
-                        //       for (auto it6=GateMap.begin();it6!=GateMap.end();++it6) {
-                        //          if((MA_wt2[it6->first] != 2) && (MA_gd[it6->first] != 2) && (MA_wt[it6->first] != MA_gd[it6->first])) {
-                        //             cout << "alternative multi-gate: " << it6->first << " & " <<it3->first  << " & " << it4->first << " -> " << it2->first << "\n"; 
-                        //          }
-                        //       }
-                        //    }
-                        // }
-                        // isConflict = false;
-                     }
-                  }
-            //       // cout << (result_gd? "SAT" : "UNSAT") << endl;
-
-            //       //reset 
-                  vv.clear();
-                  vb.clear();
-                  solver.assumeRelease();
-                  solver.resetAssign();
-                  
-                  for (auto it4=GateMap.begin();it4!=GateMap.end();++it4){
-                     MA_gd[it4->first] = 2;
-                  }
-                  if (findwire || findgate) {
-                     break;
-                  }
-               }
+// -APply: drop the cached results of the targets whose fanin or fanout cone
+// has a gate changed by rarCommit() since the last call, and of those whose
+// alternatives use a gate swept since. The others are not re-analyzed.
+// (Only taking the targets whose cones have a changed wire loses some
+// alternatives, since the MAs also reach the side inputs of the cones)
+void CirMgr::rarInvalidate() {
+   int n = GateMap.rbegin()->first + 1;
+   vector<bool> inTfi(n, false), inTfo(n, false);
+   vector<CirGate*> tfi, tfo;
+   for (size_t i=0; i<_rarEdited.size(); ++i) {
+      auto it = GateMap.find(_rarEdited[i]);
+      if (it == GateMap.end() || it->second == const0) continue;
+      tfi.push_back(it->second);
+      tfo.push_back(it->second);
+   }
+   _rarEdited.clear();
+   while (!tfi.empty()) {
+      CirGate* g = tfi.back();
+      tfi.pop_back();
+      if (inTfi[g->getID()]) continue;
+      inTfi[g->getID()] = true;
+      if (g->getFanin0() && g->getFanin0() != const0) tfi.push_back(g->getFanin0());
+      if (g->getFanin1() && g->getFanin1() != const0) tfi.push_back(g->getFanin1());
+   }
+   while (!tfo.empty()) {
+      CirGate* g = tfo.back();
+      tfo.pop_back();
+      if (inTfo[g->getID()]) continue;
+      inTfo[g->getID()] = true;
+      vector<CirGate*> fanout = g->getFanout();
+      tfo.insert(tfo.end(), fanout.begin(), fanout.end());
+   }
+   for (size_t t=0; t<_rarCache.size(); ++t) {
+      vector<RarRecord>& c = _rarCache[t];
+      bool keep = !c.empty() && int(t) < n && !inTfi[t] && !inTfo[t] && GateMap.count(t);
+      for (size_t j=0; keep && j<c.size(); ++j) {
+         if (c[j].gd >= 0 && !GateMap.count(c[j].gd)) keep = false;
+         for (int k=0; k<3; ++k) if (c[j].src[k] >= 0 && !GateMap.count(c[j].src[k])) keep = false;
+      }
+      if (!keep) c.clear();
+   }
+}
+
+// CIRSatRAR -Apply: commit the alternatives found by rarAnalyze() to the
+// netlist until a round removes no gate
+void CirMgr::rarApply() {
+
+   // CNF of the netlist; kept up to date by rarCommit()
+   SatSolver s;
+   s.initialize();
+   s.assertProperty(0, false);
+   vector<Var> vars(GateMap.rbegin()->first + 1, 0);
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      vars[it->first] = s.newVar();
+   }
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      CirGate* g = it->second;
+      if (g->getTypeStr() != "Aig") continue;
+      s.addAigCNF(vars[it->first], vars[g->getFanin0()->getID()], g->getInv0(),
+                  vars[g->getFanin1()->getID()], g->getInv1());
+   }
+
+   // -Verify: the POs of the netlist before the first commit; after -Resume,
+   // those of the netlist the run started from, which the checkpoint keeps
+   vector<Lit> po0;
+   if (_rarOpt.verify && _rarOpt.resume) {
+      CirMgr orig;
+      istringstream aag(_rarNetlist0);
+      orig.readCircuit(aag);
+      orig.rarEncode(s, vars, po0);
+   }
+   else for (size_t i=0; i<_polist.size(); ++i) {
+      po0.push_back(Lit(vars[_polist[i]->getFanin0()->getID()], _polist[i]->getInv0()));
+   }
+
+   // with -TOp, a round only sees the first targets with alternatives; those
+   // whose alternatives are all rejected are left out of the next rounds
+   if (!_rarOpt.resume) {
+      _rarRejected.assign(GateMap.rbegin()->first + 1, false);
+      _rarCache.clear();
+   }
+   _rarEdited.clear();
+   for (bool more = true; more; ) {
+      bool changed = false, rejected = false;
+      vector<int> targets;
+      vector<vector<RarAlt>> alts;
+      size_t nTop = _rarStops[RAR_TOP];
+      size_t rec = _rarResults.size();   // of the round's first target
+      rarAnalyze(targets, alts);
+      for (size_t i=0; i<targets.size(); ++i) {
+         size_t j = 0;
+         for (; j<alts[i].size(); ++j) {
+            if (rarCommit(s, vars, targets[i], alts[i][j])) {
+               _rarResults[rec + j].applied = true;
+               changed = true; ++_rarApplied; break;
             }
          }
+         if (_rarOpt.top && j && j == alts[i].size()) {
+            if (_rarRejected.size() <= size_t(targets[i])) _rarRejected.resize(targets[i] + 1, false);
+            _rarRejected[targets[i]] = true;
+            rejected = true;
+         }
+         rec += alts[i].empty()? 1: alts[i].size();
       }
+      more = changed || (rejected && _rarStops[RAR_TOP] > nTop);
+      rarInvalidate();
+      if (!_rarOpt.checkpoint.empty()) rarSave(0);
+      if (rarTimedOut()) break;
    }
+   _rarRejected.clear();
+   _rarCache.clear();
+
+   cout << "#round: " << _rarRound << " #apply: " << _rarApplied
+        << " #aig: " << _rarAig0 << " -> " << _aiglist.size() << "\n";
+   if (_rarRound > 1) cout << "#reuse: " << _rarReused << " targets from earlier rounds\n";
+   if (_rarOpt.verify)
+      cout << "#verify: " << (rarVerify(s, vars, po0)? "equivalent": "NOT equivalent") << "\n";
+   rarReportStops();
+}
 
-   cout << "#tar: " << count_tar << " #alt: " << count_alt << "\n";
-   cout << "test: " << test << "\n";
-   cout << GateMap.size() << "\n";
-}
\ No newline at end of file
+// -Verify after -Resume: add the CNF of this netlist (the one the run started
+// from) to "s", with the Vars "vars" of the current netlist for CONST0 and the
+// PIs, which the commits keep; its POs go to "po"
+void CirMgr::rarEncode(SatSolver& s, const vector<Var>& vars, vector<Lit>& po) const {
+   vector<Var> v(GateMap.rbegin()->first + 1, vars[0]);
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      const string& type = it->second->getTypeStr();
+      if (type == "Aig" || size_t(it->first) >= vars.size()) v[it->first] = s.newVar();
+      else if (type != "Po") v[it->first] = vars[it->first];
+   }
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      CirGate* g = it->second;
+      if (g->getTypeStr() != "Aig") continue;
+      s.addAigCNF(v[it->first], v[g->getFanin0()->getID()], g->getInv0(),
+                  v[g->getFanin1()->getID()], g->getInv1());
+   }
+   for (size_t i=0; i<_polist.size(); ++i) {
+      po.push_back(Lit(v[_polist[i]->getFanin0()->getID()], _polist[i]->getInv0()));
+   }
+}
+
+// -Verify: encode the netlist again from its gates (PIs and CONST0 keep
+// vars[g]) and check its POs against "po0", which are those of the netlist
+// before the commits. Unlike the miters of rarCommit(), this does not rely
+// on the CNF kept up to date by the commits
+bool CirMgr::rarVerify(SatSolver& s, const vector<Var>& vars, const vector<Lit>& po0) {
+   vector<bool> region(GateMap.rbegin()->first + 1, false);
+   for (auto it=GateMap.begin(); it!=GateMap.end(); ++it) {
+      if (it->second->getTypeStr() == "Aig") region[it->first] = true;
+   }
+   vector<Lit> fresh(region.size(), lit_Undef);
+   Var act = s.newVar();
+   vector<Var> vv(1, act);
+   vector<bool> vb(1, true);
+   for (size_t i=0; i<_polist.size(); ++i) {
+      Lit lf = rarShadow(s, vars, fresh, region, _polist[i]->getFanin0());
+      if (_polist[i]->getInv0()) lf = ~lf;
+      Var x = s.newVar();
+      s.addXorCNF(x, var(po0[i]), sign(po0[i]), var(lf), sign(lf));
+      vv.push_back(x);
+      vb.push_back(false);
+   }
+   s.addCNF(vv, vb);
+   s.assumeRelease();
+   s.assumeProperty(act, true);
+   bool differ = s.assumpSolve();
+   s.assumeRelease();
+   s.assertProperty(act, false);
+   return !differ;
+}
@@ -14,6 +14,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <chrono>
 
 using namespace std;
 
@@ -22,6 +23,97 @@ using namespace std;
 
 extern CirMgr *cirMgr;
 
+// Target orders of CIRSatRAR -Order; all but RAR_ORDER_ID put the larger keys first
+enum RarOrder
+{
+   RAR_ORDER_ID      = 0,   // gate IDs
+   RAR_ORDER_FANOUT  = 1,   // number of fanouts
+   RAR_ORDER_LEVEL   = 2,   // logic level
+   RAR_ORDER_CONE    = 3,   // fanin cone size, counting shared fanins once per path
+   RAR_ORDER_GAIN    = 4,   // MFFC size, the AIGs removed with the target
+
+   RAR_ORDER_TOT
+};
+
+struct RarCheckpoint;
+
+// Options of CIRSatRAR
+struct RarOption
+{
+   RarOption(): aigImp(false), lazyCnf(false), apply(false), simFilter(true), threads(1),
+                multi(false), window(0), order(RAR_ORDER_ID), top(0),
+                timeout(0), maxTargets(0), maxCands(0), maxProps(0), out(0), csv(false),
+                resume(0), verify(false) {}
+   bool        aigImp;     // compute MAs with CirImp instead of the SAT solver
+   bool        lazyCnf;    // give the SAT solver only the CNF of the cones of the targets so far
+   bool        apply;      // rewrite the netlist with the alternatives found
+   bool        simFilter;  // skip the candidate queries refuted by random simulation
+   unsigned    threads;    // number of worker threads
+   bool        multi;      // also look for alternative gates of 2 and 3 inputs by pairs of candidates
+   unsigned    window;     // levels of the local window of each target, 0 for the whole netlist
+   RarOrder    order;      // of the targets, for analysis and report
+   unsigned    top;        // stop after this many targets with alternatives, 0 for no limit
+   // budgets, 0 for no limit
+   unsigned    timeout;    // wall-clock seconds of the whole command
+   unsigned    maxTargets; // targets analyzed (the first ones of the order)
+   unsigned    maxCands;   // candidate queries per target
+   unsigned    maxProps;   // propagations per target (RARSolve or CirImp)
+   // -OUtput: the results go to "out" (CSV or JSON Lines) and the console
+   // only gets periodic progress and the summary; 0 for the full console report
+   ostream*    out;
+   bool        csv;
+   string      checkpoint; // -CHeckpoint file of the run, empty for none
+   const RarCheckpoint* resume;  // -Resume: the state to continue from, 0 for a new run
+   bool        verify;     // -APply: check the final netlist against the one it started from
+};
+
+// One result of CIRSatRAR (see CirMgr::getRarResults()): an alternative of a
+// target, or the target alone (type "none") if none was found
+struct RarRecord
+{
+   RarRecord(): round(0), target(-1), gd(-1), queries(0), seconds(0), stop(0), applied(false),
+      cached(false) {
+      src[0] = src[1] = src[2] = -1; val[0] = val[1] = val[2] = false; }
+   const char* type() const {
+      return src[0] < 0? "none": src[1] < 0? "wire": src[2] < 0? "gate": "multi"; }
+
+   unsigned    round;      // analysis round, 1 unless -APply
+   int         target, gd; // gd is -1 for "none"
+   int         src[3];     // inputs of the alternative, -1 if unused
+   bool        val[3];     // their values in the MAs of the target
+   unsigned    queries;    // candidate queries of the target
+   double      seconds;    // analysis time of the target
+   int         stop;       // RarStop of the target
+   bool        applied;    // committed to the netlist by -APply
+   bool        cached;     // reused from an earlier round of -APply
+};
+
+// State of a CIRSatRAR run, saved by -CHeckpoint and continued by -Resume
+struct RarCheckpoint
+{
+   // binary file; write() replaces "file" only once the new one is complete
+   bool write(const string& file) const;
+   bool read(const string& file);
+   // same options for the results as "o" (threads, budgets of time, -OUtput... aside)
+   bool sameOptions(const RarOption& o) const;
+
+   RarOption                  opt;
+   string                     netlist;   // .aag of the netlist when saved
+   string                     original;  // -APply: .aag of the netlist before the first round (for -Verify)
+   unsigned                   round;     // analysis rounds finished
+   unsigned                   applied;   // -APply: alternatives committed so far
+   unsigned                   aig;       // -APply: AIGs before the first round
+   vector<bool>               rejected;  // CirMgr::_rarRejected
+   vector<RarRecord>          results;   // of the rounds finished
+   vector<vector<RarRecord>>  done;      // of the targets (by ID) analyzed on "netlist"
+};
+
+class RarMA;
+struct RarAlt;
+struct RarWorker;
+struct RarPool;
+struct RarWindow;
+
 // TODO: Define your own data members and member functions
 class CirMgr
 {
@@ -39,6 +131,7 @@ public:
     }
    // Member functions about circuit construction
    bool readCircuit(const string&);
+   bool readCircuit(istream&);
    void connect();
 
    // Member functions about circuit reporting
@@ -48,7 +141,10 @@ public:
    void printPOs() const;
    void printFloatGates() const;
    void writeAag(ostream&) const;
-   void satRAR() ;
+   void satRAR(const RarOption& opt = RarOption()) ;
+   // the results of the last satRAR(), in the order of the targets of each round
+   const vector<RarRecord>& getRarResults() const { return _rarResults; }
+   void probe();
    void satRARtest() ;
    
 
@@ -69,17 +165,60 @@ int                             A;
 mutable int                             flAIG;
 CirGate*                            const0;
 map<int,CirGate*>       GateMap;
+RarOption                      _rarOpt;
+vector<int>                    _idom;      // immediate dominator toward the POs
+vector<int>                    _domPost;   // DFS postorder of the reversed circuit
+size_t                         _rarQueries, _rarSimSkips;   // of the last rarAnalyze()
+size_t                         _rarMulti;      // alternatives found by rarMulti() in the last rarAnalyze()
+double                         _rarMultiTime;  // and the seconds spent in it, summed over the threads
+size_t                         _rarWinGates;   // window sizes summed over the targets of the last rarAnalyze()
+chrono::steady_clock::time_point  _rarStart, _rarDeadline;  // of satRAR(), of -TImeout
+unsigned                       _rarRound;      // rarAnalyze() calls since satRAR()
+vector<RarRecord>              _rarResults;    // since satRAR()
+vector<vector<RarRecord>>      _rarCache;      // -APply: results of the targets (by ID) still valid
+vector<int>                    _rarEdited;     // gates changed by rarCommit() since rarInvalidate()
+size_t                         _rarReused;     // targets taken from _rarCache, since satRAR()
+unsigned                       _rarApplied, _rarAig0;  // -APply: commits so far, AIGs at the start
+string                         _rarNetlist0;   // -APply: .aag of the netlist at the start, for -CHeckpoint
+chrono::steady_clock::time_point  _rarNextSave;         // of -CHeckpoint
+size_t                         _rarUntried;    // targets over -MAXTargets, since satRAR()
+vector<size_t>                 _rarStops;      // targets stopped early for each RarStop, since satRAR()
+vector<bool>                   _rarRejected;   // targets left out by rarApply() (by ID)
+bool rarTimedOut() const;
+void rarReportStops() const;
+void rarProgress(RarPool&) const;
+void rarWriteResults(ostream&, bool) const;
+void rarSave(const RarPool*) const;
+void rarSaveDue(RarPool&, size_t);
+void rarRestore(const RarCheckpoint&);
 void readHeader(string header);
 void readInput(string input,int l);
 void readOutput(string output,int l);
 void readAig(string Aig,int l);
 void readSymbol(string symbol);
 void resetprint() const;
-void findAllgd(int, vector<pair<int, int>>&, map<int, int>&); // (Id, 0or1)
-void compareTwogds(vector<pair<int, int>>&, vector<pair<int, int>>&);
+void buildDomTree();
+void findDoms(int, vector<pair<int, int>>&, RarMA&) const; // (Id, 0or1or2)
 void traverseWt(int, map<int, int>&, bool, bool&);
 bool combineMAs(map<int, int>&, map<int, int>&);
 vector<int> isConflict(map<int, int>&, map<int, int>&);
+void rarAnalyze(vector<int>&, vector<vector<RarAlt>>&);
+void rarOrder(vector<int>&) const;
+void rarApply();
+void rarInvalidate();
+bool rarCommit(SatSolver&, vector<Var>&, int, const RarAlt&);
+Lit rarShadow(SatSolver&, const vector<Var>&, vector<Lit>&, const vector<bool>&, CirGate*) const;
+int rarSweep(vector<CirGate*>&, vector<CirGate*>&);
+bool rarVerify(SatSolver&, const vector<Var>&, const vector<Lit>&);
+void rarEncode(SatSolver&, const vector<Var>&, vector<Lit>&) const;
+void rarWork(RarWorker&, RarPool&, unsigned);
+int rarTarget(RarWorker&, int, vector<RarAlt>&);
+int rarMulti(RarWorker&, int, const vector<pair<int,int>>&, const vector<int>&, const vector<Var>&,
+             const vector<bool>&, unsigned&, vector<RarAlt>&);
+SatSolver* rarWindow(RarWindow&, int) const;
+void rarLazy(RarWindow&, SatSolver&, int) const;
+bool rarImply(SatSolver&, CirImp&, const vector<Var>&, const vector<bool>&, const vector<int>&, RarMA&,
+              const RarWindow* = 0);
 static bool mysort(CirGate const *p1,CirGate const* p2);
 };
 
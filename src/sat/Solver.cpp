@@ -29,7 +29,7 @@ int effLimit = INT_MAX;
 // Helper functions:
 
 
-void removeWatch(vec<Clause*>& ws, Clause* elem)
+void removeWatch(vec<CRef>& ws, CRef elem)
 {
     if (ws.size() == 0) return;     // (skip lists that are already cleared)
     int j = 0;
@@ -66,6 +66,8 @@ void Solver::newClause(const vec<Lit>& ps_, bool learnt, ClauseId id , bool A)
 {
     assert(learnt || id == ClauseId_NULL);
     if (!ok) return;
+    clearImpCache();
+    if (!learnt) resetTrail();      // (may follow 'RARSolve()', which keeps its assumptions)
 
     vec<Lit>    qs;
     if (!learnt){
@@ -106,9 +108,26 @@ void Solver::newClause(const vec<Lit>& ps_, bool learnt, ClauseId id , bool A)
         if (!enqueue(ps[0]))
             ok = false;
 
+    }else if (ps.size() == 2 && proof == NULL){
+        // Binary clause -- stored implicitly as two implications, no 'Clause' is allocated:
+        Lit     p = ps[0], q = ps[1];
+        if (learnt){
+            // Enqueue asserting literal ('q' is the only other literal, so it is the reason):
+            check(enqueue(p, GClause_new(q)));
+            stats.learnts_literals += 2;
+            bin_learnts[index(~p)].push(q);
+            bin_learnts[index(~q)].push(p);
+            n_bin_learnts++;
+        }else{
+            stats.clauses_literals += 2;
+            bin_watches[index(~p)].push(q);
+            bin_watches[index(~q)].push(p);
+            n_bin_clauses++; }
+
     }else{
         // Allocate clause:
-        Clause* c   = Clause_new(learnt, ps, id);
+        CRef    cr  = ca.alloc(learnt, ps, id);
+        Clause& c   = ca[cr];
 
         if (learnt){
             // Put the second watch on the literal with highest decision level:
@@ -118,27 +137,27 @@ void Solver::newClause(const vec<Lit>& ps_, bool learnt, ClauseId id , bool A)
                 if (level[var(ps[i])] > max)
                     max   = level[var(ps[i])],
                     max_i = i;
-            (*c)[1]     = ps[max_i];
-            (*c)[max_i] = ps[1];
+            c[1]     = ps[max_i];
+            c[max_i] = ps[1];
 
             // Bumping:
             claBumpActivity(c); // (newly learnt clauses should be considered active)
 
             // Enqueue asserting literal:
-            check(enqueue((*c)[0], c));
+            check(enqueue(c[0], GClause_new(cr)));
 
             // Store clause:
-            watches[index(~(*c)[0])].push(c);
-            watches[index(~(*c)[1])].push(c);
-            learnts.push(c);
-            stats.learnts_literals += c->size();
+            watches[index(~c[0])].push(cr);
+            watches[index(~c[1])].push(cr);
+            learnts.push(cr);
+            stats.learnts_literals += c.size();
 
         }else{
             // Store clause:
-            watches[index(~(*c)[0])].push(c);
-            watches[index(~(*c)[1])].push(c);
-            clauses.push(c);
-            stats.clauses_literals += c->size();
+            watches[index(~c[0])].push(cr);
+            watches[index(~c[1])].push(cr);
+            clauses.push(cr);
+            stats.clauses_literals += c.size();
         }
     }
 }
@@ -146,19 +165,21 @@ void Solver::newClause(const vec<Lit>& ps_, bool learnt, ClauseId id , bool A)
 
 // Disposes a clauses and removes it from watcher lists. NOTE! Low-level; does NOT change the 'clauses' and 'learnts' vector.
 //
-void Solver::remove(Clause* c, bool just_dealloc)
+void Solver::remove(CRef cr, bool just_dealloc)
 {
+    Clause& c = ca[cr];
     if (!just_dealloc){
-        removeWatch(watches[index(~(*c)[0])], c),
-        removeWatch(watches[index(~(*c)[1])], c);
+        removeWatch(watches[index(~c[0])], cr),
+        removeWatch(watches[index(~c[1])], cr);
 
-        if (c->learnt()) stats.learnts_literals -= c->size();
-        else             stats.clauses_literals -= c->size();
+        if (c.learnt()) stats.learnts_literals -= c.size();
+        else            stats.clauses_literals -= c.size();
+        if (c.learnt() && c.tier() == tier_Core) n_core_learnts--;
 
-        if (proof != NULL) proof->deleted(c->id());
+        if (proof != NULL) proof->deleted(c.id());
     }
 
-    xfree(c);
+    ca.free(cr);
 }
 
 
@@ -166,11 +187,11 @@ void Solver::remove(Clause* c, bool just_dealloc)
 // the clause is binary and satisfied, in which case the first literal is true)
 // Returns True if clause is satisfied (will be removed), False otherwise.
 //
-bool Solver::simplify(Clause* c) const
+bool Solver::simplify(const Clause& c) const
 {
     assert(decisionLevel() == 0);
-    for (int i = 0; i < c->size(); i++){
-        if (value((*c)[i]) == l_True)
+    for (int i = 0; i < c.size(); i++){
+        if (value(c[i]) == l_True)
             return true;
     }
     return false;
@@ -189,17 +210,144 @@ Var Solver::newVar() {
     index = nVars();
     watches     .push();          // (list for positive literal)
     watches     .push();          // (list for negative literal)
-    reason      .push(NULL);
+    bin_watches .push();          // (list for positive literal)
+    bin_watches .push();          // (list for negative literal)
+    bin_learnts .push();          // (list for positive literal)
+    bin_learnts .push();          // (list for negative literal)
+    reason      .push(GClause_NULL);
     assigns     .push(toInt(l_Undef));
     level       .push(-1);
     trail_pos   .push(-1);
     activity    .push(0);
     order       .newVar();
     analyze_seen.push(0);
+    polarity    .push(1);
+    blocked     .push(0);
+    imp_cache   .push();          // (list for positive literal)
+    imp_cache   .push();          // (list for negative literal)
+    imp_cache_props.push(0);
+    imp_cache_props.push(0);
+    rar_dirty_seen .push(0);
+    rar_dirty_seen .push(0);
+    lbd_seen    .growTo(index + 2, 0);    // (levels range over 0..nVars())
     if (proof != NULL) unit_id.push(ClauseId_NULL);
     return index; }
 
 
+template<class T>
+static void copyNested(const vec<vec<T> >& from, vec<vec<T> >& to)
+{
+    to.clear();
+    to.growTo(from.size());
+    for (int i = 0; i < from.size(); i++)
+        from[i].copyTo(to[i]);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  clone : [void]  ->  [Solver*]
+|  
+|  Description:
+|    Returns a new solver with a copy of the whole state: problem and learnt clauses (in its own
+|    arena; clause references are offsets, so they stay valid), watches, assignments, activities,
+|    variable order, blocked variables and RAR caches, and parameters. The two solvers are then
+|    fully independent (e.g. one per thread).
+|________________________________________________________________________________________________@*/
+Solver* Solver::clone() const
+{
+    assert(proof == NULL);
+    Solver* s = new Solver();
+
+    s->ok = ok;
+    ca.copyTo(s->ca);
+    clauses.copyTo(s->clauses);
+    learnts.copyTo(s->learnts);
+    s->n_core_learnts = n_core_learnts;
+    unit_id.copyTo(s->unit_id);
+    s->cla_inc   = cla_inc;
+    s->cla_decay = cla_decay;
+    activity.copyTo(s->activity);
+    s->var_inc   = var_inc;
+    s->var_decay = var_decay;
+    copyNested(watches, s->watches);
+    copyNested(bin_watches, s->bin_watches);
+    s->n_bin_clauses = n_bin_clauses;
+    copyNested(bin_learnts, s->bin_learnts);
+    s->n_bin_learnts = n_bin_learnts;
+    assigns.copyTo(s->assigns);
+    order.copyTo(s->order);
+    trail.copyTo(s->trail);
+    trail_lim.copyTo(s->trail_lim);
+    s->reason.clear();
+    for (int i = 0; i < reason.size(); i++) s->reason.push(reason[i]);   // ('GClause' has no default constructor for 'copyTo()')
+    level.copyTo(s->level);
+    trail_pos.copyTo(s->trail_pos);
+    polarity.copyTo(s->polarity);
+    blocked.copyTo(s->blocked);
+    blocked_vars.copyTo(s->blocked_vars);
+    rar_assumps.copyTo(s->rar_assumps);
+    implied_lim.copyTo(s->implied_lim);
+    copyNested(imp_cache, s->imp_cache);
+    imp_cache_keys.copyTo(s->imp_cache_keys);
+    s->imp_cache_lits = imp_cache_lits;
+    imp_cache_props.copyTo(s->imp_cache_props);
+    s->rar_base       = rar_base;
+    rar_moved.copyTo(s->rar_moved);
+    rar_dirty.copyTo(s->rar_dirty);
+    rar_dirty_seen.copyTo(s->rar_dirty_seen);
+    s->phase_saving   = phase_saving;
+    s->reduce_mode    = reduce_mode;
+    s->root_level     = root_level;
+    s->qhead          = qhead;
+    s->simpDB_assigns = simpDB_assigns;
+    s->simpDB_props   = simpDB_props;
+    analyze_seen.copyTo(s->analyze_seen);
+    lbd_seen.copyTo(s->lbd_seen);
+    s->lbd_stamp      = lbd_stamp;
+
+    s->stats           = stats;
+    s->default_params  = default_params;
+    s->expensive_ccmin = expensive_ccmin;
+    s->garbage_frac    = garbage_frac;
+    s->core_lbd        = core_lbd;
+    s->tier2_lbd       = tier2_lbd;
+    s->imp_cache_limit = imp_cache_limit;
+    s->rar_props_left  = rar_props_left;
+    s->verbosity       = verbosity;
+    s->progress_estimate = progress_estimate;
+    model.copyTo(s->model);
+    conflict.copyTo(s->conflict);
+    implied.copyTo(s->implied);
+    s->conflict_id     = conflict_id;
+    return s;
+}
+
+
+// Drop all entries of the implication cache of 'RARSolve()'.
+void Solver::clearImpCache() {
+    for (int i = 0; i < imp_cache_keys.size(); i++)
+        imp_cache[index(imp_cache_keys[i])].clear(true);
+    imp_cache_keys.clear();
+    imp_cache_lits = 0; }
+
+
+// Undo the assignments above the top level, and put the watches moved by 'RARpropagate()' back
+// as they are in 'rar_base', so that the next 'RARSolve()' does not depend on the calls before.
+// O(size of the clauses and watch lists changed since the last call).
+void Solver::restoreRAR() {
+    assert(rar_base != NULL);
+    resetTrail();
+    for (int i = 0; i < rar_moved.size(); i++){
+        Clause&       c = ca[rar_moved[i]];
+        const Clause& b = rar_base->ca[rar_moved[i]];
+        for (int k = 0; k < c.size(); k++) c[k] = b[k]; }
+    for (int i = 0; i < rar_dirty.size(); i++){
+        rar_base->watches[rar_dirty[i]].copyTo(watches[rar_dirty[i]]);
+        rar_dirty_seen[rar_dirty[i]] = 0; }
+    rar_moved.clear();
+    rar_dirty.clear(); }
+
+
 // Returns FALSE if immediate conflict.
 bool Solver::assume(Lit p) {
     trail_lim.push(trail.size());
@@ -211,8 +359,9 @@ void Solver::cancelUntil(int level) {
     if (decisionLevel() > level){
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var     x  = var(trail[c]);
+            if (phase_saving) polarity[x] = sign(trail[c]);
             assigns[x] = toInt(l_Undef);
-            reason [x] = NULL;
+            reason [x] = GClause_NULL;
             order.undo(x); }
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
@@ -246,7 +395,7 @@ public:
     lastToFirst_lt(const vec<int>& t) : trail_pos(t) {}
     bool operator () (Lit p, Lit q) { return trail_pos[var(p)] > trail_pos[var(q)]; }
 };
-void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
+void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel, int& out_lbd)
 {
     vec<char>&     seen  = analyze_seen;
     int            pathC = 0;
@@ -262,8 +411,15 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
         assert(confl != NULL);  // (otherwise should be UIP)
 
         Clause& c = *confl;
-        if (c.learnt())
-            claBumpActivity(&c);
+        if (c.learnt()){
+            claBumpActivity(c);
+            c.setUsed(true);
+            if (c.tier() != tier_Core){
+                // Promote clauses whose LBD improved under the current assignment:
+                int lbd = computeLBD(c);
+                if (lbd < c.lbd()) setLearntTier(c, lbd);
+            }
+        }
 
         for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++){
             Lit q = c[j];
@@ -285,7 +441,7 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
         // Select next clause to look at:
         while (!seen[var(trail[index--])]);
         p     = trail[index+1];
-        confl = reason[var(p)];
+        confl = reasonClause(reason[var(p)], analyze_tmpbin);
         seen[var(p)] = 0;
         pathC--;
         if (pathC == 0) break;
@@ -306,18 +462,18 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
 
         analyze_toclear.clear();
         for (i = j = 1; i < out_learnt.size(); i++)
-            if (reason[var(out_learnt[i])] == NULL || !analyze_removable(out_learnt[i], min_level))
+            if (reason[var(out_learnt[i])] == GClause_NULL || !analyze_removable(out_learnt[i], min_level))
                 out_learnt[j++] = out_learnt[i];
     }else if(expensive_ccmin == 1){
         // Simplify conflict clause (a little):
         //
         analyze_toclear.clear();
         for (i = j = 1; i < out_learnt.size(); i++){
-            Clause* r = reason[var(out_learnt[i])];
-            if (r == NULL)
+            GClause r = reason[var(out_learnt[i])];
+            if (r == GClause_NULL)
                 out_learnt[j++] = out_learnt[i];
             else{
-                Clause& c = *r;
+                Clause& c = *reasonClause(r, analyze_tmpbin);
                 for (int k = 1; k < c.size(); k++)
                     if (!seen[var(c[k])] && level[var(c[k])] != 0){
                         out_learnt[j++] = out_learnt[i];
@@ -336,7 +492,7 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
         for (int k = 0; k < analyze_toclear.size(); k++){
             Var     v = var(analyze_toclear[k]); assert(level[v] > 0);
 				Lit     l = analyze_toclear[k];
-            Clause& c = *reason[v];
+            Clause& c = ca[reason[v].clause()];   // (binary clauses are not inlined when logging proofs)
             proof->resolve(c.id(), l);
             for (int k = 1; k < c.size(); k++)
                 if (level[var(c[k])] == 0)
@@ -352,6 +508,44 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
     stats.max_literals += out_learnt.size();
     out_learnt.shrink(i - j);
     stats.tot_literals += out_learnt.size();
+    out_lbd = computeLBD(out_learnt);
+}
+
+
+// Literal block distance: the number of distinct decision levels among the literals of 'c'. All
+// literals must be assigned. Small LBD clauses connect few "blocks" of the search and tend to stay
+// useful (Audemard & Simon, "Predicting learnt clauses quality in modern SAT solvers").
+//
+template<class C>
+int Solver::computeLBD(const C& c)
+{
+    if (++lbd_stamp == 0){
+        // (stamp wrapped around)
+        for (int i = 0; i < lbd_seen.size(); i++) lbd_seen[i] = 0;
+        lbd_stamp = 1; }
+    int     lbd = 0;
+    for (int i = 0; i < c.size(); i++){
+        int l = level[var(c[i])];
+        if (lbd_seen[l] != lbd_stamp){
+            lbd_seen[l] = lbd_stamp;
+            lbd++; }
+    }
+    return lbd;
+}
+
+
+// Record 'lbd' in the learnt clause 'c' and move it up to the tier it qualifies for (clauses are
+// only demoted by 'reduceDB()').
+//
+void Solver::setLearntTier(Clause& c, int lbd)
+{
+    c.setLbd(lbd);
+    if (c.tier() == tier_Core) return;
+    if (lbd <= core_lbd){
+        c.setTier(tier_Core);
+        n_core_learnts++;
+    }else if (lbd <= tier2_lbd)
+        c.setTier(tier_Tier2);
 }
 
 
@@ -359,17 +553,17 @@ void Solver::analyze(Clause* confl, vec<Lit>& out_learnt, int& out_btlevel)
 //
 bool Solver::analyze_removable(Lit p, uint min_level)
 {
-    assert(reason[var(p)] != NULL);
+    assert(reason[var(p)] != GClause_NULL);
     analyze_stack.clear(); analyze_stack.push(p);
     int top = analyze_toclear.size();
     while (analyze_stack.size() > 0){
-        assert(reason[var(analyze_stack.last())] != NULL);
-        Clause& c = *reason[var(analyze_stack.last())];
+        assert(reason[var(analyze_stack.last())] != GClause_NULL);
+        Clause& c = *reasonClause(reason[var(analyze_stack.last())], analyze_tmpbin);
         analyze_stack.pop();
         for (int i = 1; i < c.size(); i++){
             Lit p = c[i];
             if (!analyze_seen[var(p)] && level[var(p)] != 0){
-                if (reason[var(p)] != NULL && ((1 << (level[var(p)] & 31)) & min_level) != 0){
+                if (reason[var(p)] != GClause_NULL && ((1 << (level[var(p)] & 31)) & min_level) != 0){
                     analyze_seen[var(p)] = 1;
                     analyze_stack.push(p);
                     analyze_toclear.push(p);
@@ -422,12 +616,12 @@ void Solver::analyzeFinal(Clause* confl, bool skip_first)
         Var     x = var(trail[i]);
 		  Lit     l = trail[i];
         if (seen[x]){
-            Clause* r = reason[x];
-            if (r == NULL){
+            GClause r = reason[x];
+            if (r == GClause_NULL){
                 assert(level[x] > 0);
                 conflict.push(~trail[i]);
             }else{
-                Clause& c = *r;
+                Clause& c = *reasonClause(r, analyze_tmpbin);
                 if (proof != NULL) proof->resolve(c.id(), l);
                 for (int j = 1; j < c.size(); j++)
                     if (level[var(c[j])] > 0)
@@ -452,13 +646,13 @@ void Solver::analyzeFinal(Clause* confl, bool skip_first)
 |  
 |  Input:
 |    p    - The fact to enqueue
-|    from - [Optional] Fact propagated from this (currently) unit clause. Stored in 'reason[]'.
-|           Default value is NULL (no reason).
+|    from - [Optional] Fact propagated from this (currently) unit clause, or the false literal of
+|           an implicit binary clause. Stored in 'reason[]'. Default value is GClause_NULL (no reason).
 |  
 |  Output:
 |    TRUE if fact was enqueued without conflict, FALSE otherwise.
 |________________________________________________________________________________________________@*/
-bool Solver::enqueue(Lit p, Clause* from)
+bool Solver::enqueue(Lit p, GClause from)
 {   
     
     if (value(p) != l_Undef) {
@@ -477,6 +671,31 @@ bool Solver::enqueue(Lit p, Clause* from)
 
 
 
+// Propagates the implicit binary clauses watching 'p'. If a conflict arises, 'confl' is set to
+// 'propagate_tmpbin' (filled with the conflicting binary clause), the propagation queue is emptied
+// and TRUE is returned.
+//
+bool Solver::propagateBinary(Lit p, Clause*& confl)
+{
+    for (int type = 0; type < 2; type++){
+        vec<Lit>&   bs = (type ? bin_learnts : bin_watches)[index(p)];
+        for (int k = 0; k < bs.size(); k++){
+            Lit imp = bs[k];
+            if (!enqueue(imp, GClause_new(~p))){
+                if (decisionLevel() == 0)
+                    ok = false;
+                confl = propagate_tmpbin;
+                (*confl)[0] = imp;
+                (*confl)[1] = ~p;
+                qhead = trail.size();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  propagate : [void]  ->  [Clause*]
@@ -496,11 +715,16 @@ Clause* Solver::propagate()
         simpDB_props--;
 
         Lit            p  = trail[qhead++];     // 'p' is enqueued fact to propagate.
-        vec<Clause*>&  ws = watches[index(p)];
-        Clause**       i,** j,** end;
+        vec<CRef>&     ws = watches[index(p)];
+        CRef*          i,* j,* end;
+
+        // Binary clauses first -- the implied literals are stored directly in the watcher list:
+        if (propagateBinary(p, confl))
+            continue;
 
-        for (i = j = (Clause**)ws, end = i + ws.size();  i != end;){
-            Clause& c = **i; i++;
+        for (i = j = (CRef*)ws, end = i + ws.size();  i != end;){
+            CRef    cr = *i++;
+            Clause& c  = ca[cr];
             // Make sure the false literal is data[1]:
             Lit false_lit = ~p;
             if (c[0] == false_lit)
@@ -512,13 +736,13 @@ Clause* Solver::propagate()
             Lit   first = c[0];
             lbool val   = value(first);
             if (val == l_True){
-                *j++ = &c;
+                *j++ = cr;
             }else{
                 // Look for new watch:
                 for (int k = 2; k < c.size(); k++)
                     if (value(c[k]) != l_False){
                         c[1] = c[k]; c[k] = false_lit;
-                        watches[index(~c[1])].push(&c);
+                        watches[index(~c[1])].push(cr);
                         goto FoundWatch; }
 
                 // Did not find watch -- clause is unit under assignment:
@@ -539,8 +763,8 @@ Clause* Solver::propagate()
                     }
                 }
 					 
-                *j++ = &c;
-                if (!enqueue(first, &c)){
+                *j++ = cr;
+                if (!enqueue(first, GClause_new(cr))){
                     if (decisionLevel() == 0)
                         ok = false;
                     confl = &c;
@@ -552,8 +776,6 @@ Clause* Solver::propagate()
               FoundWatch:;
             }
         }
-        printf( "id: %d, value: %d\n", index(p)/2, (index(p)+1)%2);
-
         ws.shrink(i - j);
     }
 
@@ -562,7 +784,7 @@ Clause* Solver::propagate()
 
 // for satRAR propagation
 
-Clause* Solver::RARpropagate(std::map<int, int>& MA, std::vector<int>& fanout)
+Clause* Solver::RARpropagate()
 {
     Clause* confl = NULL;
 
@@ -573,31 +795,30 @@ Clause* Solver::RARpropagate(std::map<int, int>& MA, std::vector<int>& fanout)
 
     while (qhead < trail.size()){
 
+        if (rar_props_left == 0) break;         // (out of budget; 'RARSolve()' drops the levels)
+        if (rar_props_left > 0) rar_props_left--;
         stats.propagations++;
         simpDB_props--;
 
         Lit            p  = trail[qhead++];     // 'p' is enqueued fact to propagate.
-        vec<Clause*>&  ws = watches[index(p)];
-        Clause**       i,** j,** end;
+        vec<CRef>&     ws = watches[index(p)];
+        CRef*          i,* j,* end;
         
-        bool flag = 0;
-
-        for (size_t i=0; i<fanout.size(); ++i) {
-            if (index(p)/2 == fanout[i]) {
-                flag = 1;
-            }
-        }
-
-        if (flag == 1) {
+        if (blocked[var(p)])
             continue;
-            flag = 0;
-        }
 
 
         // printf( "propagation id: %d, value: %d\n", index(p)/2, (index(p)+1)%2);
 
-        for (i = j = (Clause**)ws, end = i + ws.size();  i != end;){
-            Clause& c = **i; i++;
+        // Binary clauses first -- the implied literals are stored directly in the watcher list:
+        if (propagateBinary(p, confl)){
+            implied.push(p);
+            continue;
+        }
+
+        for (i = j = (CRef*)ws, end = i + ws.size();  i != end;){
+            CRef    cr = *i++;
+            Clause& c  = ca[cr];
             // Make sure the false literal is data[1]:
             Lit false_lit = ~p;
             if (c[0] == false_lit)
@@ -609,13 +830,18 @@ Clause* Solver::RARpropagate(std::map<int, int>& MA, std::vector<int>& fanout)
             Lit   first = c[0];
             lbool val   = value(first);
             if (val == l_True){
-                *j++ = &c;
+                *j++ = cr;
             }else{
                 // Look for new watch:
                 for (int k = 2; k < c.size(); k++)
                     if (value(c[k]) != l_False){
                         c[1] = c[k]; c[k] = false_lit;
-                        watches[index(~c[1])].push(&c);
+                        watches[index(~c[1])].push(cr);
+                        if (rar_base != NULL){
+                            // (the swap of c[0] and c[1] above needs no undo: which of the two comes first does not matter)
+                            rar_moved.push(cr);
+                            if (!rar_dirty_seen[index(p)])    { rar_dirty_seen[index(p)] = 1;    rar_dirty.push(index(p)); }
+                            if (!rar_dirty_seen[index(~c[1])]){ rar_dirty_seen[index(~c[1])] = 1; rar_dirty.push(index(~c[1])); } }
                         goto FoundWatch; }
 
                 // Did not find watch -- clause is unit under assignment:
@@ -636,8 +862,8 @@ Clause* Solver::RARpropagate(std::map<int, int>& MA, std::vector<int>& fanout)
                     }
                 }
 					 
-                *j++ = &c;
-                if (!enqueue(first, &c)){
+                *j++ = cr;
+                if (!enqueue(first, GClause_new(cr))){
                     if (decisionLevel() == 0)
                         ok = false;
                     confl = &c;
@@ -650,7 +876,7 @@ Clause* Solver::RARpropagate(std::map<int, int>& MA, std::vector<int>& fanout)
             }
         }
         // printf( "propagation id: %d, value: %d\n", index(p)/2, (index(p)+1)%2);
-        MA[index(p)/2] = (index(p)+1)%2;
+        implied.push(p);
         ws.shrink(i - j);
     }
 
@@ -665,27 +891,108 @@ Clause* Solver::RARpropagate(std::map<int, int>& MA, std::vector<int>& fanout)
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
 |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|
+|    Under the LBD policy ('reduce_LBD'), only the local tier is halved this way. Core clauses
+|    (LBD <= 'core_lbd') are kept for good; tier2 clauses (LBD <= 'tier2_lbd') are kept as long as
+|    they took part in conflict analysis since the previous call, otherwise they drop to the local
+|    tier.
 |________________________________________________________________________________________________@*/
-struct reduceDB_lt { bool operator () (Clause* x, Clause* y) { return x->size() > 2 && (y->size() == 2 || x->activity() < y->activity()); } };
+struct reduceDB_lt {
+    ClauseAllocator& ca;
+    reduceDB_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) { return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity()); } };
 void Solver::reduceDB()
 {
     int     i, j;
+
+    if (reduce_mode == reduce_LBD){
+        vec<CRef>   local;
+        for (i = j = 0; i < learnts.size(); i++){
+            Clause& c = ca[learnts[i]];
+            if (c.tier() == tier_Tier2){
+                if (c.used())
+                    c.setUsed(false);
+                else
+                    c.setTier(tier_Local);
+            }
+            if (c.tier() == tier_Local)
+                local.push(learnts[i]);
+            else
+                learnts[j++] = learnts[i];
+        }
+        learnts.shrink(i - j);
+
+        sort(local, reduceDB_lt(ca));
+        for (i = 0; i < local.size(); i++){
+            if (i < local.size() / 2 && ca[local[i]].size() > 2 && !locked(local[i]))
+                remove(local[i]);
+            else
+                learnts.push(local[i]);
+        }
+        checkGarbage();
+        return;
+    }
+
     double  extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
 
-    sort(learnts, reduceDB_lt());
+    sort(learnts, reduceDB_lt(ca));
     for (i = j = 0; i < learnts.size() / 2; i++){
-        if (learnts[i]->size() > 2 && !locked(learnts[i]))
+        if (ca[learnts[i]].size() > 2 && !locked(learnts[i]))
             remove(learnts[i]);
         else
             learnts[j++] = learnts[i];
     }
     for (; i < learnts.size(); i++){
-        if (learnts[i]->size() > 2 && !locked(learnts[i]) && learnts[i]->activity() < extra_lim)
+        if (ca[learnts[i]].size() > 2 && !locked(learnts[i]) && ca[learnts[i]].activity() < extra_lim)
             remove(learnts[i]);
         else
             learnts[j++] = learnts[i];
     }
     learnts.shrink(i - j);
+    checkGarbage();
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  garbageCollect : ()  ->  [void]
+|  
+|  Description:
+|    Compact the clause region: all live clauses are copied into a fresh 'ClauseAllocator' and every
+|    reference to them (watches, reasons, clause lists) is updated. Called when the space wasted by
+|    removed clauses exceeds 'garbage_frac' of the region.
+|________________________________________________________________________________________________@*/
+void Solver::relocAll(ClauseAllocator& to)
+{
+    // All watchers:
+    for (int i = 0; i < watches.size(); i++){
+        vec<CRef>& ws = watches[i];
+        for (int j = 0; j < ws.size(); j++)
+            ca.reloc(ws[j], to);
+    }
+
+    // All reasons (only assigned variables can have one):
+    for (int i = 0; i < trail.size(); i++){
+        Var v = var(trail[i]);
+        if (reason[v] != GClause_NULL && !reason[v].isLit()){
+            CRef cr = reason[v].clause();
+            ca.reloc(cr, to);
+            reason[v] = GClause_new(cr);
+        }
+    }
+
+    // All learnt and problem clauses:
+    for (int i = 0; i < learnts.size(); i++) ca.reloc(learnts[i], to);
+    for (int i = 0; i < clauses.size(); i++) ca.reloc(clauses[i], to);
+}
+
+void Solver::garbageCollect()
+{
+    ClauseAllocator to(ca.size() - ca.wasted());
+    relocAll(to);
+    if (verbosity >= 2)
+        reportf("|  Garbage collection:   %12d words => %12d words                |\n", ca.size(), to.size());
+    to.moveTo(ca);
 }
 
 
@@ -714,26 +1021,57 @@ void Solver::simplifyDB()
         Lit p = trail[i];
         watches[index( p)].clear(true);
         watches[index(~p)].clear(true);
+
+        // Binary clauses containing 'p' are satisfied, those containing '~p' have been propagated.
+        // Each clause '(l | q)' is listed in 'bin_watches[~l]' and 'bin_watches[~q]' (or 'bin_learnts[]');
+        // remove both copies, so that a clause with both literals at top level is only counted once:
+        for (int type = 0; type < 2; type++){
+            vec<vec<Lit> >& ws = type ? bin_learnts : bin_watches;
+            for (int k = 0; k < 2; k++){
+                Lit         l  = k ? ~p : p;
+                vec<Lit>&   bs = ws[index(~l)];
+                for (int i = 0; i < bs.size(); i++){
+                    vec<Lit>& os = ws[index(~bs[i])];
+                    for (int j = 0; j < os.size(); j++)
+                        if (os[j] == l){ os[j] = os.last(); os.pop(); break; } }
+                if (type){ n_bin_learnts -= bs.size(); stats.learnts_literals -= 2*bs.size(); }
+                else     { n_bin_clauses -= bs.size(); stats.clauses_literals -= 2*bs.size(); }
+                bs.clear(true);
+            }
+        }
     }
 
     // Remove satisfied clauses:
     for (int type = 0; type < 2; type++){
-        vec<Clause*>& cs = type ? learnts : clauses;
+        vec<CRef>&    cs = type ? learnts : clauses;
         int           j  = 0;
         for (int i = 0; i < cs.size(); i++){
-            if (!locked(cs[i]) && simplify(cs[i]))
+            if (!locked(cs[i]) && simplify(ca[cs[i]]))
                 remove(cs[i]);
             else
                 cs[j++] = cs[i];
         }
         cs.shrink(cs.size()-j);
     }
+    checkGarbage();
 
     simpDB_assigns = nAssigns();
     simpDB_props   = stats.clauses_literals + stats.learnts_literals;   // (shouldn't depend on 'stats' really, but it will do for now)
 }
 
 
+// Pick a decision literal: the variable comes from 'order', the sign is FALSE, or the saved phase
+// if 'params.phase_saving' is set. Returns 'lit_Undef' if all variables are assigned.
+//
+Lit Solver::pickBranchLit(const SearchParams& params)
+{
+    Var next = order.select(params.random_var_freq);
+    if (next == var_Undef)
+        return lit_Undef;
+    return params.phase_saving ? Lit(next, polarity[next]) : ~Lit(next);
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  search : (nof_conflicts : int) (nof_learnts : int) (params : const SearchParams&)  ->  [lbool]
@@ -757,6 +1095,8 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
     int     conflictC = 0;
     var_decay = 1 / params.var_decay;
     cla_decay = 1 / params.clause_decay;
+    phase_saving = params.phase_saving;
+    reduce_mode  = params.reduce;
     model.clear();
 
     for (;;){
@@ -766,14 +1106,16 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
 
             stats.conflicts++; conflictC++;
             vec<Lit>    learnt_clause;
-            int         backtrack_level;
+            int         backtrack_level, lbd;
             if (decisionLevel() == root_level){
                 // Contradiction found:
                 analyzeFinal(confl);
                 return l_False; }
-            analyze(confl, learnt_clause, backtrack_level);
+            analyze(confl, learnt_clause, backtrack_level, lbd);
             cancelUntil(max(backtrack_level, root_level));
+            int         n_learnts = learnts.size();
             newClause(learnt_clause, true, (proof != NULL) ? proof->last() : ClauseId_NULL);
+            if (learnts.size() > n_learnts) setLearntTier(ca[learnts.last()], lbd);
             if (learnt_clause.size() == 1) level[var(learnt_clause[0])] = 0;    // (this is ugly (but needed for 'analyzeFinal()') -- in future versions, we will backtrack past the 'root_level' and redo the assumptions)
             varDecayActivity();
             claDecayActivity();
@@ -791,15 +1133,15 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
                 // Simplify the set of problem clauses:
                 simplifyDB(), assert(ok);
 
-            if (nof_learnts >= 0 && learnts.size()-nAssigns() >= nof_learnts)
+            if (nof_learnts >= 0 && learnts.size()-(reduce_mode == reduce_LBD ? n_core_learnts : 0)-nAssigns() >= nof_learnts)
                 // Reduce the set of learnt clauses:
                 reduceDB();
 
             // New variable decision:
             stats.decisions++;
-            Var next = order.select(params.random_var_freq);
+            Lit next = pickBranchLit(params);
 
-            if (next == var_Undef){
+            if (next == lit_Undef){
                 // Model found:
                 model.growTo(nVars());
                 for (int i = 0; i < nVars(); i++) model[i] = value(i);
@@ -807,7 +1149,7 @@ lbool Solver::search(int nof_conflicts, int nof_learnts, const SearchParams& par
                 return l_True;
             }
 
-            check(assume(~Lit(next)));
+            check(assume(next));
         }
     }
 }
@@ -841,11 +1183,37 @@ void Solver::varRescaleActivity()
 void Solver::claRescaleActivity()
 {
     for (int i = 0; i < learnts.size(); i++)
-        learnts[i]->activity() *= 1e-20;
+        ca[learnts[i]].activity() *= 1e-20;
     cla_inc *= 1e-20;
 }
 
 
+// Finite subsequences of the Luby-sequence:
+//
+//   0: 1
+//   1: 1 1 2
+//   2: 1 1 2 1 1 2 4
+//   3: 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8
+//   ...
+//
+// Returns the 'x':th element (counting from 0) of the sequence scaled by powers of 'y'.
+//
+static double luby(double y, int x)
+{
+    // Find the finite subsequence that contains index 'x', and the size of that subsequence:
+    int size, seq;
+    for (size = 1, seq = 0; size < x+1; seq++, size = 2*size+1);
+
+    while (size-1 != x){
+        size = (size-1)>>1;
+        seq--;
+        x = x % size;
+    }
+
+    return pow(y, seq);
+}
+
+
 /*_________________________________________________________________________________________________
 |
 |  solve : (assumps : const vec<Lit>&)  ->  [bool]
@@ -861,6 +1229,7 @@ void Solver::claRescaleActivity()
 |________________________________________________________________________________________________@*/
 bool Solver::solve(const vec<Lit>& assumps)
 {
+    resetTrail();       // (may follow 'RARSolve()', which keeps its assumptions)
     simplifyDB();
     if (!ok) return false;
 
@@ -868,6 +1237,7 @@ bool Solver::solve(const vec<Lit>& assumps)
     double  nof_conflicts = 100;
     double  nof_learnts   = nClauses() / 3;
     lbool   status        = l_Undef;
+    int64   starts0       = stats.starts;
 
     // Perform assumptions:
     root_level = assumps.size();
@@ -875,8 +1245,8 @@ bool Solver::solve(const vec<Lit>& assumps)
         Lit p = assumps[i];
         assert(var(p) < nVars());
         if (!assume(p)){
-            if (reason[var(p)] != NULL){
-                analyzeFinal(reason[var(p)], true);
+            if (reason[var(p)] != GClause_NULL){
+                analyzeFinal(reasonClause(reason[var(p)], propagate_tmpbin), true);
                 conflict.push(~p);
             }else{
                 assert(proof == NULL || unit_id[var(p)] != ClauseId_NULL);   // (this is the pre-condition above)
@@ -892,7 +1262,6 @@ bool Solver::solve(const vec<Lit>& assumps)
             cancelUntil(0);
             return false; }
     }
-    return true;
     assert(root_level == decisionLevel());
 
     // Search:
@@ -919,6 +1288,8 @@ bool Solver::solve(const vec<Lit>& assumps)
                    progress_estimate*100);
             fflush(stdout);
         }
+        if (params.restart == restart_Luby)
+            nof_conflicts = luby(2, (int)(stats.starts - starts0)) * params.luby_unit;
         status = search((int)nof_conflicts, (int)nof_learnts, params);
         nof_conflicts *= 1.5;
         nof_learnts   *= 1.1;
@@ -953,24 +1324,51 @@ void Solver::printStats()
 
 // for satRAR propagation
 
-bool Solver::RARSolve(const vec<Lit>& assumps, std::map<int, int>& MA, std::vector<int>& fanout)
+bool Solver::RARSolve(const vec<Lit>& assumps)
 {
     // simplifyDB();
-    if (!ok) return false;
-
-    SearchParams    params(default_params);
-    double  nof_conflicts = 100;
-    double  nof_learnts   = nClauses() / 3;
-    lbool   status        = l_Undef;
-
-    // Perform assumptions:
+    if (!ok){ implied.clear(); return false; }
+    assert(rar_assumps.size() == decisionLevel());
+
+    // A single assumption with nothing blocked may be cached (it costs the propagations it took).
+    // With 'rar_base', such a call starts and ends with the watches of 'rar_base', so that what it
+    // implies, and the state it leaves, depend neither on the calls before nor on the cache:
+    bool cacheable = assumps.size() == 1 && blocked_vars.size() == 0;
+    if (cacheable && rar_base != NULL) restoreRAR();
+    if (cacheable && imp_cache[index(assumps[0])].size() > 0){
+        int props = imp_cache_props[index(assumps[0])];
+        resetTrail();
+        if (rar_props_left >= 0 && rar_props_left < props){
+            rar_props_left = 0;
+            implied.clear();
+            return true; }
+        if (rar_props_left > 0) rar_props_left -= props;
+        imp_cache[index(assumps[0])].copyTo(implied);
+        stats.imp_cache_hits++;
+        return true; }
+    int64 props0 = stats.propagations;
+
+    // Keep the levels of the longest common prefix with the previous call's assumptions:
+    int keep = 0;
+    while (keep < rar_assumps.size() && keep < assumps.size() && rar_assumps[keep] == assumps[keep])
+        keep++;
+    if (keep < implied_lim.size()){
+        implied.shrink(implied.size() - implied_lim[keep]);
+        implied_lim.shrink(implied_lim.size() - keep); }
+    else if (keep == 0)
+        implied.clear();
+    cancelUntil(keep);
+    rar_assumps.shrink(rar_assumps.size() - keep);
+
+    // Perform the remaining assumptions:
     root_level = assumps.size();
-    for (int i = 0; i < assumps.size(); i++){
+    for (int i = keep; i < assumps.size(); i++){
         Lit p = assumps[i];
         assert(var(p) < nVars());
+        implied_lim.push(implied.size());
         if (!assume(p)){
-            if (reason[var(p)] != NULL){
-                analyzeFinal(reason[var(p)], true);
+            if (reason[var(p)] != GClause_NULL){
+                analyzeFinal(reasonClause(reason[var(p)], propagate_tmpbin), true);
                 conflict.push(~p);
             }else{
                 assert(proof == NULL || unit_id[var(p)] != ClauseId_NULL);   // (this is the pre-condition above)
@@ -978,15 +1376,106 @@ bool Solver::RARSolve(const vec<Lit>& assumps, std::map<int, int>& MA, std::vect
                 conflict.push(~p);
                 if (proof != NULL) conflict_id = unit_id[var(p)];
             }
-            cancelUntil(0);
+            cancelUntil(i);     // (levels of 'assumps[0..i-1]' are still valid)
             return false; }
-        Clause* confl = RARpropagate(MA, fanout);
+        Clause* confl = RARpropagate();
+        if (confl == NULL && RARBudgetOut() && qhead < trail.size()){
+            resetTrail();
+            implied.clear();
+            return true; }
         if (confl != NULL){
             analyzeFinal(confl);
-            cancelUntil(0);
+            cancelUntil(i);
             return false; }
+        rar_assumps.push(p);
     }
+    if (cacheable && implied.size() > 0 && imp_cache_lits + implied.size() <= imp_cache_limit){
+        implied.copyTo(imp_cache[index(assumps[0])]);
+        imp_cache_props[index(assumps[0])] = stats.propagations - props0;
+        imp_cache_keys.push(assumps[0]);
+        imp_cache_lits += implied.size(); }
+    if (cacheable && rar_base != NULL) restoreRAR();
     return true;
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  probe : (units : vec<Lit>&) (equivs : vec<Lit>&)  ->  [bool]
+|  
+|  Description:
+|    Failed-literal probing at the top level: every unassigned variable 'v' is assumed in both
+|    polarities and propagated. A failing polarity makes the other one a top-level unit, literals
+|    implied by both become units, and 'q' implied by 'v' while '~q' is implied by '~v' gives
+|    'v == q'. Returns FALSE if the problem turned out to be unsatisfiable.
+|  
+|  Output:
+|    'units' gets all literals fixed at the top level afterwards. 'equivs' gets the equivalences
+|    as pairs '(Lit(v), q)' with 'var(q) > v', where 'v' and 'var(q)' are both unassigned.
+|________________________________________________________________________________________________@*/
+bool Solver::probe(vec<Lit>& units, vec<Lit>& equivs)
+{
+    assert(proof == NULL);      // (top-level units are not logged)
+    resetTrail();
+    if (ok && propagate() != NULL) ok = false;
+
+    vec<char>   pos_seen(nVars(), 0);   // 'pos_seen[x]' is '1 + sign' of the literal of 'x' implied by 'v' (0 if none).
+    vec<Lit>    pos_implied, new_units, cand;
+    for (Var v = 0; v < nVars() && ok; v++){
+        if (value(v) != l_Undef) continue;
+        stats.probes++;
+
+        // Positive polarity:
+        pos_implied.clear();
+        assume(Lit(v));
+        bool pos_fail = propagate() != NULL;
+        if (!pos_fail)
+            for (int i = trail_lim[0] + 1; i < trail.size(); i++)
+                pos_implied.push(trail[i]);
+        cancelUntil(0);
+
+        // Negative polarity:
+        new_units.clear();
+        cand.clear();
+        if (pos_fail)
+            new_units.push(~Lit(v));
+        else{
+            for (int i = 0; i < pos_implied.size(); i++)
+                pos_seen[var(pos_implied[i])] = 1 + sign(pos_implied[i]);
+            assume(~Lit(v));
+            if (propagate() != NULL)
+                new_units.push(Lit(v));
+            else
+                for (int i = trail_lim[0] + 1; i < trail.size(); i++){
+                    Lit q = trail[i];
+                    if (pos_seen[var(q)] == 1 + sign(q))
+                        new_units.push(q);
+                    else if (pos_seen[var(q)] != 0 && var(q) > v)
+                        cand.push(~q); }    // (v -> ~q and ~v -> q)
+            cancelUntil(0);
+            for (int i = 0; i < pos_implied.size(); i++)
+                pos_seen[var(pos_implied[i])] = 0;
+        }
+
+        for (int i = 0; i < cand.size(); i++){
+            equivs.push(Lit(v));
+            equivs.push(cand[i]); }
+        if (new_units.size() > 0) clearImpCache();
+        for (int i = 0; i < new_units.size() && ok; i++){
+            stats.probe_units++;
+            if (!enqueue(new_units[i]) || propagate() != NULL)
+                ok = false; }
+    }
+
+    // An equivalence is only reported while both its variables are free:
+    int j = 0;
+    for (int i = 0; i < equivs.size(); i += 2)
+        if (value(equivs[i]) == l_Undef && value(equivs[i+1]) == l_Undef){
+            equivs[j++] = equivs[i];
+            equivs[j++] = equivs[i+1]; }
+    equivs.shrink(equivs.size() - j);
+
+    for (int i = 0; i < trail.size(); i++)
+        units.push(trail[i]);
+    return ok;
+}
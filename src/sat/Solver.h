@@ -24,7 +24,6 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "VarOrder.h"
 #include "Proof.h"
 #include <vector>
-#include <map>
 
 // Redfine if you want output to go somewhere else:
 #define reportf(format, args...) ( printf(format , ## args), fflush(stdout) )
@@ -37,14 +36,24 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 struct SolverStats {
     int64   starts, decisions, propagations, conflicts;
     int64   clauses_literals, learnts_literals, max_literals, tot_literals;
+    int64   probes, probe_units, imp_cache_hits;
     SolverStats() : starts(0), decisions(0), propagations(0), conflicts(0)
-      , clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0) { }
+      , clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+      , probes(0), probe_units(0), imp_cache_hits(0) { }
 };
 
 
+enum RestartMode { restart_Geometric, restart_Luby };
+enum ReduceMode  { reduce_Activity, reduce_LBD };
+
 struct SearchParams {
     double  var_decay, clause_decay, random_var_freq;    // (reasonable values are: 0.95, 0.999, 0.02)    
-    SearchParams(double v = 1, double c = 1, double r = 0) : var_decay(v), clause_decay(c), random_var_freq(r) { }
+    RestartMode restart;        // Geometric: 100 conflicts, then *1.5 per restart. Luby: 'luby_unit' times the Luby sequence 1,1,2,1,1,2,4,...
+    int     luby_unit;          // (reasonable value is: 100)
+    bool    phase_saving;       // Branch on the value a variable had when it was last unassigned instead of always on FALSE.
+    ReduceMode reduce;          // Activity: 'reduceDB()' removes the less active half of all learnts. LBD: tiered retention by literal block distance.
+    SearchParams(double v = 1, double c = 1, double r = 0, RestartMode rm = restart_Geometric, bool ps = false, ReduceMode red = reduce_LBD)
+        : var_decay(v), clause_decay(c), random_var_freq(r), restart(rm), luby_unit(100), phase_saving(ps), reduce(red) { }
 };
 
 
@@ -53,8 +62,10 @@ protected:
     // Solver state:
     //
     bool                ok;               // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
-    vec<Clause*>        clauses;          // List of problem clauses.
-    vec<Clause*>        learnts;          // List of learnt clauses.
+    ClauseAllocator     ca;               // Region holding all problem and learnt clauses (addressed by 32-bit 'CRef's).
+    vec<CRef>           clauses;          // List of problem clauses.
+    vec<CRef>           learnts;          // List of learnt clauses.
+    int                 n_core_learnts;   // Number of learnt clauses in the core tier (never removed by 'reduceDB()').
     vec<ClauseId>       unit_id;          // 'unit_id[var]' is the clause ID for the unit literal 'var' or '~var' (if set at toplevel).
     double              cla_inc;          // Amount to bump next clause with.
     double              cla_decay;        // INVERSE decay factor for clause activity: stores 1/decay.
@@ -64,13 +75,32 @@ protected:
     double              var_decay;        // INVERSE decay factor for variable activity: stores 1/decay. Use negative value for static variable order.
     VarOrder            order;            // Keeps track of the decision variable order.
 
-    vec<vec<Clause*> >  watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    vec<vec<CRef> >     watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    vec<vec<Lit> >      bin_watches;      // 'bin_watches[lit]' is a list of literals implied by binary clauses when 'lit' becomes true.
+    int                 n_bin_clauses;    // Number of binary clauses stored implicitly in 'bin_watches[]' (no 'Clause' allocated).
+    vec<vec<Lit> >      bin_learnts;      // As 'bin_watches[]', for the learnt binary clauses.
+    int                 n_bin_learnts;    // Number of learnt binary clauses stored implicitly in 'bin_learnts[]'.
     vec<char>           assigns;          // The current assignments (lbool:s stored as char:s).
     vec<Lit>            trail;            // Assignment stack; stores all assigments made in the order they were made.
     vec<int>            trail_lim;        // Separator indices for different decision levels in 'trail[]'.
-    vec<Clause*>        reason;           // 'reason[var]' is the clause that implied the variables current value, or 'NULL' if none.
+    vec<GClause>        reason;           // 'reason[var]' is the clause (or, for binary clauses, the other literal) that implied the variables current value, or 'GClause_NULL' if none.
     vec<int>            level;            // 'level[var]' is the decision level at which assignment was made.
     vec<int>            trail_pos;        // 'trail_pos[var]' is the variable's position in 'trail[]'. This supersedes 'level[]' in some sense, and 'level[]' will probably be removed in future releases.
+    vec<char>           polarity;         // 'polarity[var]' is the sign of the variable's last assignment (saved phase). Only updated when 'phase_saving' is set.
+    vec<char>           blocked;          // 'blocked[var]' is TRUE if 'RARpropagate()' must not propagate through 'var' (it is still assigned).
+    vec<Var>            blocked_vars;     // Variables with 'blocked[var]' set, so that 'clearBlocked()' is O(#blocked).
+    vec<Lit>            rar_assumps;      // Assumptions of the decision levels kept by 'RARSolve()' for reuse by the next call ('rar_assumps[i]' is at level 'i+1').
+    vec<int>            implied_lim;      // 'implied_lim[i]' is the size of 'implied' before 'rar_assumps[i]' was propagated (one more entry after a conflict).
+    vec<vec<Lit> >      imp_cache;        // 'imp_cache[lit]' is 'implied' of 'RARSolve()' for the single assumption 'lit' with nothing blocked (empty if not cached).
+    vec<Lit>            imp_cache_keys;   // Literals with a non-empty 'imp_cache[]' entry, so that 'clearImpCache()' is O(#cached).
+    int64               imp_cache_lits;   // Total size of the 'imp_cache[]' entries.
+    vec<int>            imp_cache_props;  // 'imp_cache_props[lit]' is the number of propagations 'imp_cache[lit]' took, charged to 'rar_props_left' on a hit.
+    const Solver*       rar_base;         // Solver this one is a clone of (no clause added since), to which 'restoreRAR()' returns the watches; NULL if none.
+    vec<CRef>           rar_moved;        // Clauses whose watches 'RARpropagate()' moved since the last 'restoreRAR()' (with 'rar_base' only; may repeat).
+    vec<int>            rar_dirty;        // Watch lists ('index(lit)') 'RARpropagate()' changed since the last 'restoreRAR()' (with 'rar_base' only).
+    vec<char>           rar_dirty_seen;   // 'rar_dirty_seen[index(lit)]' is TRUE if 'index(lit)' is in 'rar_dirty'.
+    bool                phase_saving;     // Save phases in 'cancelUntil()'. Copied from the 'SearchParams' by 'search()'.
+    ReduceMode          reduce_mode;      // Policy of 'reduceDB()'. Copied from the 'SearchParams' by 'search()'.
     int                 root_level;       // Level of first proper decision.
     int                 qhead;            // Head of queue (as index into the trail -- no more explicit propagation queue in MiniSat).
     int                 simpDB_assigns;   // Number of top-level assignments since last execution of 'simplifyDB()'.
@@ -86,6 +116,8 @@ protected:
     vec<Lit>            addUnit_tmp;
     vec<Lit>            addBinary_tmp;
     vec<Lit>            addTernary_tmp;
+    vec<uint>           lbd_seen;         // 'lbd_seen[level]' is 'lbd_stamp' if 'level' was already counted by 'computeLBD()'.
+    uint                lbd_stamp;
 
     // Main internal methods:
     //
@@ -93,14 +125,19 @@ protected:
     void        cancelUntil      (int level);
     void        record           (const vec<Lit>& clause);
 
-    void        analyze          (Clause* confl, vec<Lit>& out_learnt, int& out_btlevel); // (bt = backtrack)
+    void        analyze          (Clause* confl, vec<Lit>& out_learnt, int& out_btlevel, int& out_lbd); // (bt = backtrack)
     bool        analyze_removable(Lit p, uint min_level);                                 // (helper method for 'analyze()')
     void        analyzeFinal     (Clause* confl, bool skip_first = false);
-    bool        enqueue          (Lit fact, Clause* from = NULL);
+    bool        enqueue          (Lit fact, GClause from = GClause_NULL);
+    bool        propagateBinary  (Lit p, Clause*& confl);
     Clause*     propagate        ();
-    Clause*     RARpropagate     (std::map<int, int>&, std::vector<int>&);
+    Clause*     RARpropagate     ();
     void        reduceDB         ();
+    void        relocAll         (ClauseAllocator& to);
+    void        garbageCollect   ();
+    void        checkGarbage     () { if (ca.wasted() > ca.size() * garbage_frac) garbageCollect(); }
     Lit         pickBranchLit    (const SearchParams& params);
+    void        clearImpCache    ();
     lbool       search           (int nof_conflicts, int nof_learnts, const SearchParams& params);
     double      progressEstimate ();
 
@@ -118,25 +155,42 @@ protected:
     // Operations on clauses:
     //
     void     newClause(const vec<Lit>& ps, bool learnt = false, ClauseId id = ClauseId_NULL, bool A = true);
-    void     claBumpActivity (Clause* c) { if ( (c->activity() += cla_inc) > 1e20 ) claRescaleActivity(); }
-    void     remove          (Clause* c, bool just_dealloc = false);
-    bool     locked          (const Clause* c) const { return reason[var((*c)[0])] == c; }
-    bool     simplify        (Clause* c) const;
+    void     claBumpActivity (Clause& c) { if ( (c.activity() += cla_inc) > 1e20 ) claRescaleActivity(); }
+    void     remove          (CRef cr, bool just_dealloc = false);
+    bool     locked          (CRef cr) const { return reason[var(ca[cr][0])] == GClause_new(cr); }
+    Clause*  reasonClause    (GClause r, Clause* tmpbin) { if (!r.isLit()) return &ca[r.clause()]; (*tmpbin)[1] = r.lit(); return tmpbin; }
+    bool     simplify        (const Clause& c) const;
+    template<class C>
+    int      computeLBD      (const C& c);     // Number of distinct decision levels among the (assigned) literals of 'c'.
+    void     setLearntTier   (Clause& c, int lbd);
 
     int      decisionLevel() const { return trail_lim.size(); }
 
 public:
     Solver() : ok               (true)
+             , n_core_learnts   (0)
              , cla_inc          (1)
              , cla_decay        (1)
              , var_inc          (1)
              , var_decay        (1)
              , order            (assigns, activity)
+             , n_bin_clauses    (0)
+             , n_bin_learnts    (0)
+             , imp_cache_lits   (0)
+             , rar_base         (NULL)
+             , phase_saving     (false)
+             , reduce_mode      (reduce_LBD)
              , qhead            (0)
              , simpDB_assigns   (0)
              , simpDB_props     (0)
+             , lbd_stamp        (0)
              , default_params   (SearchParams(0.95, 0.999, 0.02))
              , expensive_ccmin  (2)
+             , garbage_frac     (0.20)
+             , core_lbd         (2)
+             , tier2_lbd        (6)
+             , imp_cache_limit  (1 << 22)
+             , rar_props_left   (-1)
              , proof            (NULL)
              , verbosity        (0)
              , progress_estimate(0)
@@ -151,12 +205,12 @@ public:
              }
 
    ~Solver() {
-       for (int i = 0; i < learnts.size(); i++) remove(learnts[i], true);
-       for (int i = 0; i < clauses.size(); i++) if (clauses[i] != NULL) remove(clauses[i], true);
-       remove(propagate_tmpbin, true);
-       remove(analyze_tmpbin, true);
+       xfree(propagate_tmpbin);
+       xfree(analyze_tmpbin);
     }
 
+    Solver* clone() const;      // Deep copy (own clause arena, watches, variable order, ...), including the current assignments. No proof logging.
+
     // Helpers: (semi-internal)
     //
     lbool   value(Var x) const { return toLbool(assigns[x]); }
@@ -165,8 +219,8 @@ public:
 //    lbool   modelValue(Lit p) const { return model[var(p)] ^ sign(p); }
 
     int     nAssigns() { return trail.size(); }
-    int     nClauses() { return clauses.size(); }
-    int     nLearnts() { return learnts.size(); }
+    int     nClauses() { return clauses.size() + n_bin_clauses; }
+    int     nLearnts() { return learnts.size() + n_bin_learnts; }
 
     // Statistics: (read-only member variable)
     //
@@ -176,6 +230,11 @@ public:
     //
     SearchParams    default_params;     // Restart frequency etc.
     int             expensive_ccmin;    // Controls conflict clause minimization. TRUE by default.
+    double          garbage_frac;       // Compact the clause region when this fraction of it is wasted. 0.20 by default.
+    int             core_lbd;           // Learnt clauses with LBD up to this are kept for good (LBD policy only). 2 by default.
+    int             tier2_lbd;          // Learnt clauses with LBD up to this are kept while they are used (LBD policy only). 6 by default.
+    int64           imp_cache_limit;    // Max. total number of literals in the implication cache of 'RARSolve()' (0 disables it). 4M by default.
+    int64           rar_props_left;     // Propagations 'RARSolve()' may still make (negative: no limit). -1 by default.
     Proof*          proof;              // Set this directly after constructing 'Solver' to enable proof logging. Initialized to NULL.
     int             verbosity;          // Verbosity level. 0=silent, 1=some progress report, 2=everything
 
@@ -183,7 +242,7 @@ public:
     //
     Var     newVar    ();
     int     nVars     ()                    { return assigns.size(); }
-    void    resetAssign ()                  { for(size_t i=0; i<assigns.size(); ++i){ assigns[i] = 0;}}
+    void    resetTrail  ()                  { cancelUntil(0); root_level = 0; rar_assumps.clear(); implied_lim.clear(); }  // Undo everything above the top level (assumptions and their implications).
     void    printAssign ()                  { for(size_t i=0; i<assigns.size(); ++i){ printf("%d\n", assigns[i]);}}
     void    addUnit   (Lit p)               { addUnit_tmp   [0] = p; addClause(addUnit_tmp); }
     void    addBinary (Lit p, Lit q)        { addBinary_tmp [0] = p; addBinary_tmp [1] = q; addClause(addBinary_tmp); }
@@ -196,12 +255,23 @@ public:
     bool    okay() { return ok; }       // FALSE means solver is in an conflicting state (must never be used again!)
     void    simplifyDB();
     bool    solve(const vec<Lit>& assumps);
-    bool    RARSolve(const vec<Lit>& assumps, std::map<int, int>&, std::vector<int>& fanout);
+    bool    RARSolve(const vec<Lit>& assumps);   // (returns TRUE with nothing implied when it runs out of 'rar_props_left')
+    bool    RARBudgetOut() const            { return rar_props_left == 0; }
+    void    setRARBase  (const Solver* s)   { rar_base = s; }   // ('this' must be a clone of 's'; see 'restoreRAR()')
+    void    restoreRAR  ();
+    bool    probe   (vec<Lit>& units, vec<Lit>& equivs);
+    void    setBlocked  (Var x)             { if (!blocked[x]){ resetTrail(); blocked[x] = 1; blocked_vars.push(x); } }   // (changing the blocked set drops the levels kept by 'RARSolve()')
+    void    clearBlocked()                  { if (blocked_vars.size() > 0) resetTrail(); for (int i = 0; i < blocked_vars.size(); i++) blocked[blocked_vars[i]] = 0; blocked_vars.clear(); }
+    bool    isBlocked   (Var x) const       { return blocked[x]; }
+    int     nBlocked    () const            { return blocked_vars.size(); }
     bool    solve() { vec<Lit> tmp; return solve(tmp); }
 
     double      progress_estimate;  // Set by 'search()'.
     vec<lbool>  model;              // If problem is satisfiable, this vector contains the model (if any).
     vec<Lit>    conflict;           // If problem is unsatisfiable under assumptions, this vector represent the conflict clause expressed in the assumptions.
+    vec<Lit>    implied;            // Literals propagated by the last 'RARSolve()' (assumptions included, blocked variables excluded), in propagation order. Kept after a conflict.
+                                    // 'RARSolve()' keeps the decision levels of the assumptions it shares as a prefix with the previous call (until 'resetTrail()', 'solve()', a new clause or a change of the blocked set), so only the rest is propagated again.
+                                    // The result of a single assumption with nothing blocked is cached per literal (until a clause or top-level unit is added), so repeating it is a copy.
     ClauseId    conflict_id;        // (In proof logging mode only.) ID for the clause 'conflict' (for proof traverseral). NOTE! The empty clause is always the last clause derived, but for conflicts under assumption, this is not necessarly true.
 
     // Printing:
@@ -81,60 +81,131 @@ const   int ClauseId_NULL = INT_MIN;
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+typedef uint CRef;        // Clause reference -- a 32-bit word offset into a 'ClauseAllocator'.
+const   CRef CRef_Undef = UINT_MAX >> 1;    // (leaves room for the tag bit of 'GClause')
+
+// Tiers of learnt clauses under the LBD reduction policy (see 'Solver::reduceDB()').
+enum LearntTier { tier_Local = 0, tier_Tier2 = 1, tier_Core = 2 };
+
 class Clause {
-    uint    size_learnt;
-    Lit     data[1];
+    uint    header;     // size << 3 | reloced << 2 | has_id << 1 | learnt
+    Lit     data[1];    // literals, then (learnt only) activity and 'lbd << 3 | used << 2 | tier', then (has_id only) id
 public:
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
     Clause(bool learnt, const vec<Lit>& ps, ClauseId id_ = ClauseId_NULL) {
-        size_learnt = (ps.size() << 1) | (int)learnt;
+        header = (ps.size() << 3) | ((int)(id_ != ClauseId_NULL) << 1) | (int)learnt;
         for (int i = 0; i < ps.size(); i++) data[i] = ps[i];
-        if (learnt) activity() = 0;
+        if (learnt) activity() = 0, meta() = ps.size() << 3 | tier_Local;
         if (id_ != ClauseId_NULL) id() = id_; }
 
     // -- use this function instead:
     friend Clause* Clause_new(bool, const vec<Lit>&, ClauseId);
 
-    int       size        ()      const { return size_learnt >> 1; }
-    bool      learnt      ()      const { return size_learnt & 1; }
+    int       size        ()      const { return header >> 3; }
+    bool      learnt      ()      const { return header & 1; }
+    bool      hasId       ()      const { return header & 2; }
+    int       words       ()      const { return 1 + size() + 2*(int)learnt() + (int)hasId(); } // (size in 32-bit words)
     Lit       operator [] (int i) const { return data[i]; }
     Lit&      operator [] (int i)       { return data[i]; }
     float&    activity    ()      const {
         void *p = const_cast<Lit*>(&data[size()]); return *((float *)p);
     } //              return *((float*)&data[size()]); }
-    ClauseId& id          ()      const { return *((ClauseId*)&data[size() + (int)learnt()]); }
+    ClauseId& id          ()      const { return *((ClauseId*)&data[size() + 2*(int)learnt()]); }
+
+    // Learnt clauses only: literal block distance, tier and whether the clause took part in conflict analysis since it was last checked.
+    int       lbd         ()      const { return meta() >> 3; }
+    LearntTier tier       ()      const { return (LearntTier)(meta() & 3); }
+    bool      used        ()      const { return meta() & 4; }
+    void      setLbd      (int l)       { meta() = (l << 3) | (meta() & 7); }
+    void      setTier     (LearntTier t){ meta() = (meta() & ~3u) | t; }
+    void      setUsed     (bool u)      { meta() = u ? (meta() | 4) : (meta() & ~4u); }
+
+    // Garbage collection: a moved clause stores its new reference in place of its first literal.
+    bool      reloced     ()      const { return header & 4; }
+    CRef      relocation  ()      const { return (CRef)index(data[0]); }
+    void      relocate    (CRef c)      { header |= 4; data[0] = toLit((int)c); }
+
+private:
+    uint&     meta        ()      const { return *((uint*)&data[size() + 1]); }
 };
 
+// Only used for the temporary binary clauses of 'Solver'; problem and learnt clauses live in a 'ClauseAllocator'.
 inline Clause* Clause_new(bool learnt, const vec<Lit>& ps, ClauseId id = ClauseId_NULL) {
     assert(sizeof(Lit)      == sizeof(uint));
     assert(sizeof(float)    == sizeof(uint));
     assert(sizeof(ClauseId) == sizeof(uint));
-    void*   mem = xmalloc<char>(sizeof(Clause) + sizeof(uint)*(ps.size() + (int)learnt + (int)(id != ClauseId_NULL)));
+    void*   mem = xmalloc<char>(sizeof(Clause) + sizeof(uint)*(ps.size() + 2*(int)learnt + (int)(id != ClauseId_NULL)));
     return new (mem) Clause(learnt, ps, id); }
 
 
+//=================================================================================================
+// ClauseAllocator -- a region of 32-bit words holding all clauses of a solver:
+
+
+// Clauses are addressed by their word offset ('CRef') instead of a pointer. Freed clauses only
+// count as wasted space; the solver compacts the region by copying the live clauses into a fresh
+// allocator (see 'Solver::garbageCollect()'). NOTE! A 'Clause&' is invalidated by 'alloc()'.
+//
+class ClauseAllocator {
+    vec<uint>   memory;
+    uint        wasted_;
+
+public:
+    ClauseAllocator(int start_cap = 1024) : wasted_(0) { memory.capacity(start_cap); }
+
+    CRef alloc(bool learnt, const vec<Lit>& ps, ClauseId id = ClauseId_NULL) {
+        assert(sizeof(Lit) == sizeof(uint) && sizeof(float) == sizeof(uint) && sizeof(ClauseId) == sizeof(uint));
+        int     words = 1 + ps.size() + 2*(int)learnt + (int)(id != ClauseId_NULL);
+        CRef    cr    = memory.size();
+        assert(cr + words < CRef_Undef);
+        memory.growTo(cr + words);
+        new (&memory[cr]) Clause(learnt, ps, id);
+        return cr; }
+
+    void          free       (CRef cr)       { wasted_ += (*this)[cr].words(); }
+    Clause&       operator[] (CRef cr)       { return *(Clause*)&memory[cr]; }
+    const Clause& operator[] (CRef cr) const { return *(const Clause*)&memory[cr]; }
+
+    uint size  () const { return memory.size(); }
+    uint wasted() const { return wasted_; }
+
+    // Copy clause 'cr' into 'to' (once) and update 'cr' to its new reference.
+    void reloc(CRef& cr, ClauseAllocator& to) {
+        Clause& c = (*this)[cr];
+        if (c.reloced()){ cr = c.relocation(); return; }
+        CRef    nr = to.memory.size();
+        to.memory.growTo(nr + c.words());
+        memcpy(&to.memory[nr], &memory[cr], c.words() * sizeof(uint));
+        c.relocate(nr);
+        cr = nr; }
+
+    void moveTo(ClauseAllocator& to) { memory.moveTo(to.memory); to.wasted_ = wasted_; wasted_ = 0; }
+    void copyTo(ClauseAllocator& to) const { memory.copyTo(to.memory); to.wasted_ = wasted_; }   // (CRefs stay valid in the copy)
+};
+
+
 //=================================================================================================
 // GClause -- Generalize clause:
 
 
-// Either a pointer to a clause or a literal.
+// Either a reference to a clause or a literal.
 class GClause {
-    void*   data;
-    GClause(void* d) : data(d) {}
+    uint    data;
+    GClause(uint d) : data(d) {}
 public:
     friend GClause GClause_new(Lit p);
-    friend GClause GClause_new(Clause* c);
+    friend GClause GClause_new(CRef c);
 
-    bool        isLit    () const { return ((uintp)data & 1) == 1; }
-    Lit         lit      () const { return toLit(((intp)data) >> 1); }
-    Clause*     clause   () const { return (Clause*)data; }
+    bool        isLit    () const { return (data & 1) == 1; }
+    Lit         lit      () const { return toLit((int)(data >> 1)); }
+    CRef        clause   () const { return data >> 1; }
     bool        operator == (GClause c) const { return data == c.data; }
     bool        operator != (GClause c) const { return data != c.data; }
 };
-inline GClause GClause_new(Lit p)     { return GClause((void*)(((intp)index(p) << 1) + 1)); }
-inline GClause GClause_new(Clause* c) { assert(((uintp)c & 1) == 0); return GClause((void*)c); }
+inline GClause GClause_new(Lit p)  { return GClause(((uint)index(p) << 1) + 1); }
+inline GClause GClause_new(CRef c) { assert(c <= CRef_Undef); return GClause(c << 1); }
 
-#define GClause_NULL GClause_new((Clause*)NULL)
+#define GClause_NULL GClause_new(CRef_Undef)
 
 
 //=================================================================================================
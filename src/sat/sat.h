@@ -11,6 +11,7 @@
 
 #include <cassert>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include "Solver.h"
 
@@ -21,6 +22,10 @@ class SatSolver
 {
    public : 
       SatSolver():_solver(0) { }
+      // Deep copy: the copy has its own clauses, learnts, watches and variable order
+      // (see Solver::clone()), e.g. to give each thread a solver without regenerating the CNF
+      SatSolver(const SatSolver& s): _solver(s._solver? s._solver->clone(): 0), _curVar(s._curVar) {
+         s._assump.copyTo(_assump); }
       ~SatSolver() { if (_solver) delete _solver; }
 
       // Solver initialization and reset
@@ -91,14 +96,41 @@ class SatSolver
       void assumeProperty(Var prop, bool val) {
          _assump.push(val? Lit(prop): ~Lit(prop));
       }
-      void assumeVec(vector<Var>& vv, vector<bool>& vb) {
+      void assumeVec(const vector<Var>& vv, const vector<bool>& vb) {
          for (size_t i=0; i<vv.size(); ++i) {
             _assump.push(vb[i]? Lit(vv[i]) : ~Lit(vv[i]));
          }
       }
       bool assumpSolve() { return _solver->solve(_assump); }
-      bool assumpRARSolve(map<int, int>& MA, vector<int>& fanout) {return _solver->RARSolve(_assump, MA, fanout);}
-      void resetAssign() { _solver->resetAssign(); }
+      // Propagate the assumptions without search, not propagating through the blocked variables;
+      // the propagated literals are left in "getImplied()".
+      // The assignments are kept until "resetTrail()", "assumpSolve()" or a new clause; the next
+      // call only redoes the assumptions after the longest prefix it shares with this one (if
+      // the blocked set is unchanged)
+      bool assumpRARSolve() { return _solver->RARSolve(_assump); }
+      // Let the following "assumpRARSolve()" calls make "props" propagations in total (< 0: no
+      // limit); once they are used up, a call that is not finished implies nothing and
+      // "RARBudgetOut()" is true
+      void setRARBudget(int64 props) { _solver->rar_props_left = props; }
+      bool RARBudgetOut() const { return _solver->RARBudgetOut(); }
+      // Block propagation through "vars" (replaces the previous set; O(#vars))
+      void setBlocked(const vector<int>& vars) {
+         if (sameBlocked(vars)) return;
+         _solver->clearBlocked();
+         for (size_t i=0; i<vars.size(); ++i) _solver->setBlocked(vars[i]);
+      }
+      void clearBlocked() { _solver->clearBlocked(); }
+      // For a copy of "s": "restoreRAR()" drops the assignments and puts the watches moved by
+      // "assumpRARSolve()" back as in "s" (O(#moved), where a new copy is O(CNF)), so that the
+      // next calls give what they would on a new copy; the implication cache is kept
+      void setRARBase(const SatSolver& s) { _solver->setRARBase(s._solver); }
+      void restoreRAR() { _solver->restoreRAR(); }
+      // Failed-literal probing of every free variable (drops the assignments of "assumpRARSolve()");
+      // "units" gets the literals fixed at the top level, "equivs" pairs (Lit(v), q) with v == q.
+      // Return false if the clauses are unsatisfiable
+      bool probe(vec<Lit>& units, vec<Lit>& equivs) { return _solver->probe(units, equivs); }
+      const vec<Lit>& getImplied() const { return _solver->implied; }
+      void resetTrail() { _solver->resetTrail(); }
       void printAssign() { _solver->printAssign(); }
 
       // For one time proof, use "solve"
@@ -113,11 +145,26 @@ class SatSolver
          return (_solver->modelValue(v)==l_True?1:
                 (_solver->modelValue(v)==l_False?0:-1)); }
       void printStats() const { const_cast<Solver*>(_solver)->printStats(); }
+      const SolverStats& getStats() const { return _solver->stats; }
+
+      // Search options used by "solve" and "assumpSolve" (restarts, phase saving, ...)
+      SearchParams& searchParams() { return _solver->default_params; }
 
    private : 
+      SatSolver& operator=(const SatSolver&);   // (not implemented; use the copy constructor)
+
       Solver           *_solver;    // Pointer to a Minisat solver
       Var               _curVar;    // Variable currently
       vec<Lit>          _assump;    // Assumption List for assumption solve
+
+      // "vars" (duplicates allowed) is exactly the current blocked set
+      bool sameBlocked(const vector<int>& vars) const {
+         for (size_t i=0; i<vars.size(); ++i)
+            if (!_solver->isBlocked(vars[i])) return false;
+         vector<int> s(vars);
+         sort(s.begin(), s.end());
+         return unique(s.begin(), s.end()) - s.begin() == _solver->nBlocked();
+      }
 };
 
 #endif  // SAT_H
@@ -1,4 +1,6 @@
 #include <iostream>
+#include <fstream>
+#include <string>
 #include <vector>
 #include <cmath>
 #include <stdlib.h>
@@ -98,6 +100,246 @@ void reportResult(const SatSolver& solver, bool result, int num, int color, int
    cout << (result? "SAT" : "UNSAT") << endl;
 }
 
+// Search modes compared by "compareModes"
+struct SearchMode
+{
+   const char*  name;
+   RestartMode  restart;
+   bool         phase;
+   ReduceMode   reduce;
+};
+
+static const SearchMode modes[] = {
+   { "geometric",       restart_Geometric, false, reduce_Activity },
+   { "geometric+phase", restart_Geometric, true,  reduce_Activity },
+   { "luby",            restart_Luby,      false, reduce_Activity },
+   { "luby+phase",      restart_Luby,      true,  reduce_Activity },
+   { "geometric/lbd",   restart_Geometric, false, reduce_LBD      },
+   { "luby+phase/lbd",  restart_Luby,      true,  reduce_LBD      }
+};
+static const int numModes = sizeof(modes) / sizeof(modes[0]);
+
+struct ModeResult
+{
+   ModeResult(): conflicts(0), decisions(0), time(0), nSat(0), nUnsat(0) {}
+   int64    conflicts, decisions;
+   double   time;
+   int      nSat, nUnsat;
+};
+
+void
+setMode(SatSolver& s, const SearchMode& m)
+{
+   s.searchParams().restart = m.restart;
+   s.searchParams().phase_saving = m.phase;
+   s.searchParams().reduce = m.reduce;
+}
+
+// One-shot random 3-SAT at the threshold ratio (#clauses/#vars = 4.26)
+void
+genRandom3Sat(SatSolver& s, int nVars, unsigned seed)
+{
+   srand(seed);
+   for (int i = 0; i < nVars; ++i) s.newVar();
+   int nClauses = (int)(nVars * 4.26);
+   vector<Var> vv(3); vector<bool> vb(3);
+   for (int i = 0; i < nClauses; ++i) {
+      for (int j = 0; j < 3; ++j) {
+         vv[j] = 1 + rand() % nVars;   // var 0 is taken by "initialize()"
+         vb[j] = rand() & 1;
+      }
+      s.addCNF(vv, vb);
+   }
+}
+
+// Incremental queries against one AIG, as in the equivalence and RAR passes:
+// for random pairs of AND gates (a, b), ask whether a = 1 and b = 0 is possible
+void
+genRandomAig(SatSolver& s, vector<Var>& ands, int nPis, int nAnds, unsigned seed)
+{
+   srand(seed);
+   vector<Var> nodes;
+   for (int i = 0; i < nPis; ++i) nodes.push_back(s.newVar());
+   for (int i = 0; i < nAnds; ++i) {
+      // Favor recent nodes so the AIG gets deep rather than wide
+      size_t n = nodes.size(), w = n < (size_t)(4 * nPis)? n: 4 * nPis;
+      Var va = nodes[n - 1 - rand() % w];
+      Var vb = nodes[n - 1 - rand() % w];
+      Var vf = s.newVar();
+      s.addAigCNF(vf, va, rand() & 1, vb, rand() & 1);
+      nodes.push_back(vf); ands.push_back(vf);
+   }
+}
+
+void
+compareModes()
+{
+   const int nInstances = 20, n3Sat = 200;
+   const int nPis = 64, nAnds = 4000, nQueries = 500;
+
+   ModeResult res[2][numModes];
+   vector<bool> answers[2];
+   for (int m = 0; m < numModes; ++m) {
+      // Workload 0: one-shot random 3-SAT
+      for (int i = 0; i < nInstances; ++i) {
+         SatSolver s; s.initialize(); setMode(s, modes[m]);
+         genRandom3Sat(s, n3Sat, 1000 + i);
+         double t = cpuTime();
+         bool r = s.solve();
+         res[0][m].time += cpuTime() - t;
+         res[0][m].conflicts += s.getStats().conflicts;
+         res[0][m].decisions += s.getStats().decisions;
+         if (r) ++res[0][m].nSat; else ++res[0][m].nUnsat;
+         if (m == 0) answers[0].push_back(r);
+         else assert(answers[0][i] == r);
+      }
+      // Workload 1: incremental assumption queries on one AIG
+      SatSolver s; s.initialize(); setMode(s, modes[m]);
+      vector<Var> ands;
+      genRandomAig(s, ands, nPis, nAnds, 7);
+      srand(77);
+      double t = cpuTime();
+      for (int q = 0; q < nQueries; ++q) {
+         Var a = ands[rand() % ands.size()], b = ands[rand() % ands.size()];
+         s.assumeRelease();
+         s.assumeProperty(a, true);
+         s.assumeProperty(b, false);
+         bool r = s.assumpSolve();
+         if (r) ++res[1][m].nSat; else ++res[1][m].nUnsat;
+         if (m == 0) answers[1].push_back(r);
+         else assert(answers[1][q] == r);
+      }
+      res[1][m].time = cpuTime() - t;
+      res[1][m].conflicts = s.getStats().conflicts;
+      res[1][m].decisions = s.getStats().decisions;
+   }
+
+   const char* titles[2] = { "random 3-SAT (one-shot)", "random AIG (incremental)" };
+   for (int w = 0; w < 2; ++w) {
+      printf("%s: %d SAT, %d UNSAT\n", titles[w], res[w][0].nSat, res[w][0].nUnsat);
+      printf("  %-16s %12s %12s %10s\n", "mode", "conflicts", "decisions", "time(s)");
+      for (int m = 0; m < numModes; ++m)
+         printf("  %-16s %12lld %12lld %10.3f\n", modes[m].name,
+                (long long)res[w][m].conflicts, (long long)res[w][m].decisions,
+                res[w][m].time);
+   }
+}
+
+
+// AND gates of an ASCII AIGER file (no latches)
+struct AagModel
+{
+   AagModel(): maxVar(0) {}
+   unsigned          maxVar;
+   vector<unsigned>  ands;   // output, fanin 0, fanin 1 literals of each gate
+};
+
+bool
+readAag(const char* fileName, AagModel& m)
+{
+   ifstream in(fileName);
+   string tag;
+   unsigned nI, nL, nO, nA, lit;
+   if (!(in >> tag >> m.maxVar >> nI >> nL >> nO >> nA) || tag != "aag" || nL != 0)
+      return false;
+   for (unsigned i = 0; i < nI + nO; ++i) in >> lit;
+   m.ands.resize(3 * nA);
+   for (unsigned i = 0; i < 3 * nA; ++i)
+      if (!(in >> m.ands[i])) return false;
+   return true;
+}
+
+// CNF of "m", AIGER variable i on Var i (Var 0, CONST0, is made by "initialize()")
+void
+genAag(SatSolver& s, const AagModel& m, vector<Var>& ands)
+{
+   for (unsigned i = 0; i < m.maxVar; ++i) s.newVar();
+   for (size_t i = 0; i < m.ands.size(); i += 3) {
+      const unsigned* g = &m.ands[i];
+      s.addAigCNF(g[0] / 2, g[1] / 2, g[1] & 1, g[2] / 2, g[2] & 1);
+      ands.push_back(g[0] / 2);
+   }
+}
+
+// Time "nReps" CNF builds by "build" against "nReps" clones of a solver that
+// has answered half of the queries, and check that the clone answers like the
+// original and does not disturb it
+template<class Build> void
+cloneCase(const char* name, int nReps, Build build)
+{
+   const int nQueries = 200;
+   vector<Var> ands;
+   double t = cpuTime();
+   for (int r = 0; r < nReps; ++r) {
+      SatSolver s; s.initialize();
+      ands.clear();
+      build(s, ands);
+   }
+   double tBuild = cpuTime() - t;
+
+   SatSolver orig; orig.initialize();
+   ands.clear();
+   build(orig, ands);
+   vector<pair<Var, Var> > queries;
+   srand(77);
+   for (int q = 0; q < nQueries; ++q)
+      queries.push_back(pair<Var, Var>(ands[rand() % ands.size()], ands[rand() % ands.size()]));
+   vector<bool> answers;
+   for (int q = 0; q < nQueries / 2; ++q) {   // (so that the clone also copies learnts)
+      orig.assumeRelease();
+      orig.assumeProperty(queries[q].first, true);
+      orig.assumeProperty(queries[q].second, false);
+      answers.push_back(orig.assumpSolve());
+   }
+
+   t = cpuTime();
+   for (int r = 0; r < nReps; ++r) { SatSolver c(orig); }
+   double tClone = cpuTime() - t;
+   printf("  %-12s %8d %12.4f %12.4f\n", name, (int)ands.size(),
+          1000 * tBuild / nReps, 1000 * tClone / nReps);
+
+   SatSolver c(orig);
+   for (int q = 0; q < nQueries; ++q) {
+      c.assumeRelease();
+      c.assumeProperty(queries[q].first, true);
+      c.assumeProperty(queries[q].second, false);
+      bool r = c.assumpSolve();
+      if (q < nQueries / 2) assert(r == answers[q]);
+      else answers.push_back(r);
+   }
+   for (int q = nQueries / 2; q < nQueries; ++q) {
+      orig.assumeRelease();
+      orig.assumeProperty(queries[q].first, true);
+      orig.assumeProperty(queries[q].second, false);
+      assert(orig.assumpSolve() == answers[q]);
+   }
+}
+
+// Clone (SatSolver copy) against regenerating the CNF, on random AIGs and on
+// the ISCAS85 circuits of tests.fraig (run from src/sat/test)
+void
+compareClone()
+{
+   const int nPis = 64;
+   const int sizes[] = { 2000, 20000, 100000 };
+   const char* iscas[] = { "C432", "C499", "C880", "C1355", "C1908", "C3540", "C5315",
+                           "C6288", "C7552" };
+
+   printf("clone vs. rebuild (ms per copy)\n");
+   printf("  %-12s %8s %12s %12s\n", "circuit", "#ands", "rebuild", "clone");
+   for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+      int n = sizes[k];
+      cloneCase("random", 10, [&](SatSolver& s, vector<Var>& ands) {
+         genRandomAig(s, ands, nPis, n, 7); });
+   }
+   for (size_t k = 0; k < sizeof(iscas) / sizeof(iscas[0]); ++k) {
+      AagModel m;
+      string file = string("../../../tests.fraig/ISCAS85/") + iscas[k] + ".aag";
+      if (!readAag(file.c_str(), m)) continue;
+      cloneCase(iscas[k], 200, [&](SatSolver& s, vector<Var>& ands) {
+         genAag(s, m, ands); });
+   }
+}
 
 int main()
 {
@@ -112,4 +354,8 @@ int main()
    solver.assumeRelease();  // Clear assumptions
    solver.assumeProperty(newV, true);  // k = 1
    result = solver.assumpSolve();
+   assert(result);
+
+   compareModes();
+   compareClone();
 }